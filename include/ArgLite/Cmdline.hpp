@@ -0,0 +1,352 @@
+#pragma once
+
+#include "Core.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#ifdef __linux__
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <fcntl.h>
+#include <thread>
+#include <unistd.h>
+#endif
+
+namespace ArgLite {
+
+/**
+ * @brief The options of a program, declared once and used to parse many command lines with `CmdlineView`.
+ * @details Unlike `Parser`, it is an object, so command lines of other processes can be parsed
+ *          on many threads at once. Option names use the same format as the get functions,
+ *          e.g., `"v,verbose"`, and the returned handle identifies the option in the result.
+ *          A schema must not be modified while it is used.
+ */
+class CmdlineSchema {
+public:
+    CmdlineSchema() { shortOpts_.fill(NONE); }
+
+    /**
+     * @brief Declares a flag option.
+     * @param optName The short name, long name, or both (e.g., "v", "verbose" or "v,verbose").
+     * @return The handle of the option.
+     */
+    std::uint32_t addFlag(std::string_view optName) { return add(optName, false); }
+
+    /**
+     * @brief Declares an option with a value, the value can be passed as `-n 1`, `-n1`, `--num 1` or `--num=1`.
+     * @param optName The short name, long name, or both (e.g., "n", "num" or "n,num").
+     * @return The handle of the option.
+     */
+    std::uint32_t addOption(std::string_view optName) { return add(optName, true); }
+
+    [[nodiscard]]
+    size_t optionCount() const { return hasValue_.size(); }
+
+private:
+    friend class CmdlineView;
+
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+    std::uint32_t add(std::string_view optName, bool hasValue) {
+        auto handle = static_cast<std::uint32_t>(hasValue_.size());
+        hasValue_.push_back(hasValue);
+
+        // The same format as `Parser::parseOptNameAsPair()`
+        if (optName.size() == 1) {
+            shortOpts_[static_cast<unsigned char>(optName[0])] = handle;
+        } else if (optName.size() > 2 && optName[1] == ',') {
+            shortOpts_[static_cast<unsigned char>(optName[0])] = handle;
+            addLong(optName.substr(2), handle);
+        } else if (!optName.empty()) {
+            addLong(optName, handle);
+        }
+        return handle;
+    }
+
+    void addLong(std::string_view longOpt, std::uint32_t handle) {
+        // A deque never moves its elements, so the keys stay valid
+        longNames_.emplace_back(longOpt);
+        longOpts_[longNames_.back()] = handle;
+    }
+
+    [[nodiscard]]
+    std::uint32_t findLong(std::string_view longOpt) const {
+        auto it = longOpts_.find(longOpt);
+        return it == longOpts_.end() ? NONE : it->second;
+    }
+
+    std::vector<bool>                                   hasValue_;
+    std::array<std::uint32_t, 256>                      shortOpts_; // NOLINT(readability-magic-numbers)
+    std::deque<std::string>                             longNames_;
+    std::unordered_map<std::string_view, std::uint32_t> longOpts_;
+};
+
+/**
+ * @brief A command line parsed against a `CmdlineSchema`, e.g., read from `/proc/<pid>/cmdline`.
+ * @details Arguments, values and positional arguments are views of the parsed buffer, nothing is copied.
+ *          Reuse one view per thread, its containers keep their memory, so parsing doesn't allocate
+ *          once they are large enough. The buffer must outlive the results.
+ */
+class CmdlineView {
+public:
+    /**
+     * @brief Parses a NUL-separated buffer, the format of `/proc/<pid>/cmdline`.
+     * @details The first argument is the program. A trailing NUL is optional.
+     * @param schema The options of the program.
+     * @param buffer The arguments, each one terminated by NUL.
+     * @return True if the command line has no unknown options and no missing values, false otherwise.
+     */
+    bool parse(const CmdlineSchema &schema, std::string_view buffer) {
+        args_.clear();
+        while (!buffer.empty()) {
+            const auto *nul    = static_cast<const char *>(std::memchr(buffer.data(), '\0', buffer.size()));
+            size_t      length = nul == nullptr ? buffer.size() : static_cast<size_t>(nul - buffer.data());
+            args_.push_back(buffer.substr(0, length));
+            buffer.remove_prefix(std::min(length + 1, buffer.size()));
+        }
+        return parseArgs(schema);
+    }
+
+    /**
+     * @brief Parses an argument vector, e.g., `argv` of `main()`.
+     */
+    bool parse(const CmdlineSchema &schema, int argc, const char *const *argv) {
+        args_.clear();
+        for (int i = 0; i < argc; i++) { args_.emplace_back(argv[i]); }
+        return parseArgs(schema);
+    }
+
+    // The first argument, empty if there is none
+    [[nodiscard]]
+    std::string_view program() const { return args_.empty() ? std::string_view() : args_.front(); }
+
+    [[nodiscard]]
+    const std::vector<std::string_view> &args() const { return args_; }
+
+    /**
+     * @brief Gets the number of times an option is passed.
+     */
+    [[nodiscard]]
+    unsigned count(std::uint32_t handle) const { return slots_[handle].count; }
+
+    /**
+     * @brief Gets the last value of an option.
+     * @param handle The handle returned by `addOption()`.
+     * @param fallback The value returned if the option has no value.
+     */
+    [[nodiscard]]
+    std::string_view value(std::uint32_t handle, std::string_view fallback = {}) const {
+        const auto &slot = slots_[handle];
+        return slot.lastValue == NONE ? fallback : values_[slot.lastValue].value;
+    }
+
+    /**
+     * @brief Gets the last value of an option, converted like the get functions of `Parser`.
+     * @return The converted value, or the fallback if there is no value or it cannot be converted.
+     */
+    template <typename T>
+    [[nodiscard]]
+    T get(std::uint32_t handle, T fallback = T{}) const {
+        const auto &slot = slots_[handle];
+        if (slot.lastValue == NONE) { return fallback; }
+
+        T result{};
+        if (!Parser::convertType(values_[slot.lastValue].value, result)) { return fallback; }
+        return result;
+    }
+
+    /**
+     * @brief Calls `func` with each value of an option in the order they are passed.
+     */
+    template <typename F>
+    void forEachValue(std::uint32_t handle, F &&func) const {
+        for (const auto &it : values_) {
+            if (it.handle == handle) { func(it.value); }
+        }
+    }
+
+    [[nodiscard]]
+    const std::vector<std::string_view> &positionals() const { return positionals_; }
+
+    // Options not declared in the schema, as they are passed
+    [[nodiscard]]
+    const std::vector<std::string_view> &unknownOptions() const { return unknownOptions_; }
+
+    // Handles of the options passed without their value
+    [[nodiscard]]
+    const std::vector<std::uint32_t> &missingValues() const { return missingValues_; }
+
+private:
+    static constexpr std::uint32_t NONE = CmdlineSchema::NONE;
+
+    struct Slot {
+        unsigned      count;
+        std::uint32_t lastValue; // Index in values_
+    };
+
+    struct Value {
+        std::uint32_t    handle;
+        std::string_view value;
+    };
+
+    void occur(std::uint32_t handle) { slots_[handle].count++; }
+
+    void occurWithValue(std::uint32_t handle, std::string_view value) {
+        slots_[handle].count++;
+        slots_[handle].lastValue = static_cast<std::uint32_t>(values_.size());
+        values_.push_back({handle, value});
+    }
+
+    // Takes the next argument as the value if it is not an option, like `Parser::preprocess()`
+    void occurWithNextValue(std::uint32_t handle, size_t &i) {
+        if (i + 1 < args_.size() && args_[i + 1].rfind('-', 0) != 0) {
+            occurWithValue(handle, args_[++i]);
+        } else {
+            occur(handle);
+            missingValues_.push_back(handle);
+        }
+    }
+
+    bool parseArgs(const CmdlineSchema &schema) {
+        slots_.assign(schema.optionCount(), {0, NONE});
+        values_.clear();
+        positionals_.clear();
+        unknownOptions_.clear();
+        missingValues_.clear();
+
+        bool allPositional = false;
+        for (size_t i = 1; i < args_.size(); i++) {
+            auto arg = args_[i];
+            if (allPositional || arg.size() <= 1 || arg[0] != '-') {
+                positionals_.push_back(arg);
+                continue;
+            }
+            if (arg == "--") {
+                allPositional = true;
+                continue;
+            }
+
+            // Long option
+            if (arg[1] == '-') {
+                auto equalsPos = arg.find('=');
+                auto handle    = schema.findLong(arg.substr(2, equalsPos == std::string_view::npos ? equalsPos : equalsPos - 2));
+                if (handle == NONE) {
+                    unknownOptions_.push_back(arg);
+                } else if (equalsPos != std::string_view::npos) {
+                    occurWithValue(handle, arg.substr(equalsPos + 1));
+                } else if (schema.hasValue_[handle]) {
+                    occurWithNextValue(handle, i);
+                } else {
+                    occur(handle);
+                }
+                continue;
+            }
+
+            // Short options, e.g., -ab, -n 123, -n123, -abn123
+            for (size_t j = 1; j < arg.size(); j++) {
+                auto handle = schema.shortOpts_[static_cast<unsigned char>(arg[j])];
+                if (handle == NONE) {
+                    unknownOptions_.push_back(arg);
+                    break;
+                }
+                if (!schema.hasValue_[handle]) {
+                    occur(handle);
+                } else if (j + 1 < arg.size()) {
+                    occurWithValue(handle, arg.substr(j + 1));
+                    break;
+                } else {
+                    occurWithNextValue(handle, i);
+                }
+            }
+        }
+
+        return unknownOptions_.empty() && missingValues_.empty();
+    }
+
+    std::vector<std::string_view> args_;
+    std::vector<Slot>             slots_;
+    std::vector<Value>            values_;
+    std::vector<std::string_view> positionals_;
+    std::vector<std::string_view> unknownOptions_;
+    std::vector<std::uint32_t>    missingValues_;
+};
+
+#ifdef __linux__
+/**
+ * @brief Parses `/proc/<pid>/cmdline` of every process against the schema, on many threads.
+ * @details Each thread reuses its buffer and `CmdlineView`, so the views passed to `func`
+ *          are only valid during the call. Processes without a command line, e.g., kernel threads,
+ *          and processes that exit during the scan are skipped.
+ * @param schema The options of the program.
+ * @param func Called as `func(pid, const CmdlineView &)` from the worker threads, concurrently.
+ * @param threadCount The number of threads, 0 to use one per core.
+ * @return The number of processes parsed.
+ */
+template <typename F>
+inline size_t scanProcCmdlines(const CmdlineSchema &schema, F &&func, unsigned threadCount = 0) {
+    std::vector<int> pids;
+    if (DIR *dir = ::opendir("/proc")) {
+        while (const dirent *entry = ::readdir(dir)) {
+            char *end = nullptr;
+            long  pid = std::strtol(entry->d_name, &end, 10); // NOLINT(readability-magic-numbers)
+            if (end != entry->d_name && *end == '\0') { pids.push_back(static_cast<int>(pid)); }
+        }
+        ::closedir(dir);
+    }
+
+    if (threadCount == 0) { threadCount = std::max(1U, std::thread::hardware_concurrency()); }
+    threadCount = static_cast<unsigned>(std::min<size_t>(threadCount, std::max<size_t>(1, pids.size())));
+
+    // Threads take small batches, so slow processes don't leave the other threads idle
+    constexpr size_t    BATCH = 64;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> parsed{0};
+
+    auto worker = [&]() {
+        std::vector<char> buffer(4096); // NOLINT(readability-magic-numbers)
+        CmdlineView       view;
+        char              path[32]; // NOLINT(readability-magic-numbers)
+        size_t            count = 0;
+
+        for (size_t begin = next.fetch_add(BATCH); begin < pids.size(); begin = next.fetch_add(BATCH)) {
+            for (size_t idx = begin; idx < std::min(begin + BATCH, pids.size()); idx++) {
+                std::snprintf(path, sizeof(path), "/proc/%d/cmdline", pids[idx]);
+                int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+                if (fd < 0) { continue; }
+
+                size_t  size   = 0;
+                ssize_t length = 0;
+                while ((length = ::read(fd, buffer.data() + size, buffer.size() - size)) > 0) {
+                    size += static_cast<size_t>(length);
+                    if (size == buffer.size()) { buffer.resize(buffer.size() * 2); }
+                }
+                ::close(fd);
+                if (size == 0) { continue; }
+
+                view.parse(schema, std::string_view(buffer.data(), size));
+                func(pids[idx], static_cast<const CmdlineView &>(view));
+                count++;
+            }
+        }
+        parsed += count;
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < threadCount; i++) { threads.emplace_back(worker); }
+    worker();
+    for (auto &thread : threads) { thread.join(); }
+
+    return parsed.load();
+}
+#endif
+
+} // namespace ArgLite
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#ifdef _WIN32
+#include <cstdio>
+#include <memory>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ArgLite {
+
+/**
+ * @brief A read-only INI or `key = value` file, used by `Parser::loadConfigFile()`.
+ * @details The file is memory-mapped (read into one buffer on Windows) and tokenized in place,
+ *          so the keys and the values are views of the mapping, valid until the file is closed.
+ *          Keys before the first `[section]` belong to the main command, a section belongs to
+ *          the subcommand with its name. Lines starting with `#` or `;` are comments, and quotes
+ *          around a value are removed. If a key is repeated in a section, the last one wins.
+ */
+class ConfigFile {
+public:
+    ConfigFile() = default;
+    ~ConfigFile() { close(); }
+
+    ConfigFile(const ConfigFile &)            = delete;
+    ConfigFile &operator=(const ConfigFile &) = delete;
+
+    ConfigFile(ConfigFile &&other) noexcept { swap(other); }
+    ConfigFile &operator=(ConfigFile &&other) noexcept {
+        if (this != &other) {
+            close();
+            swap(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Maps the file, the previous file is closed.
+     * @details Nothing is tokenized until the first lookup.
+     * @param path The path of the file.
+     * @return True if the file is opened, false otherwise.
+     */
+    bool open(std::string path) {
+        close();
+        if (!map(path.c_str())) { return false; }
+        path_   = std::move(path);
+        isOpen_ = true;
+        return true;
+    }
+
+    // Unmaps the file, views of the values are invalid after it
+    void close() {
+#ifdef _WIN32
+        buffer_.reset();
+#else
+        if (size_ != 0) { ::munmap(const_cast<char *>(data_), size_); }
+#endif
+        data_    = nullptr;
+        size_    = 0;
+        indexed_ = false;
+        isOpen_  = false;
+        sections_.clear();
+        path_.clear();
+    }
+
+    [[nodiscard]]
+    bool isOpen() const { return isOpen_; }
+
+    [[nodiscard]]
+    const std::string &path() const { return path_; }
+
+    /**
+     * @brief Looks up a key, the file is tokenized at the first lookup.
+     * @param section The section name, empty for the keys before the first section.
+     * @param key The key name.
+     * @return A view of the value in the mapping, or `std::nullopt` if the key is not found.
+     */
+    [[nodiscard]]
+    std::optional<std::string_view> find(std::string_view section, std::string_view key) {
+        if (!indexed_) { index(); }
+
+        auto sectionIt = sections_.find(section);
+        if (sectionIt == sections_.end()) { return std::nullopt; }
+        auto keyIt = sectionIt->second.find(key);
+        if (keyIt == sectionIt->second.end()) { return std::nullopt; }
+        return keyIt->second;
+    }
+
+private:
+    using Section = std::unordered_map<std::string_view, std::string_view>;
+
+    static std::string_view trim(std::string_view sv) {
+        constexpr std::string_view SPACES = " \t\r";
+        auto                       begin  = sv.find_first_not_of(SPACES);
+        if (begin == std::string_view::npos) { return {}; }
+        return sv.substr(begin, sv.find_last_not_of(SPACES) - begin + 1);
+    }
+
+    static std::string_view unquote(std::string_view sv) {
+        if (sv.size() >= 2 && (sv.front() == '"' || sv.front() == '\'') && sv.back() == sv.front()) {
+            return sv.substr(1, sv.size() - 2);
+        }
+        return sv;
+    }
+
+    // One pass over the lines, only views are stored
+    void index() {
+        indexed_ = true;
+
+        Section    *section = &sections_[std::string_view()];
+        const char *pos     = data_;
+        const char *end     = data_ + size_;
+        while (pos < end) {
+            const auto *newline = static_cast<const char *>(std::memchr(pos, '\n', end - pos));
+            const char *lineEnd = newline == nullptr ? end : newline;
+            auto        line    = trim(std::string_view(pos, lineEnd - pos));
+            pos                 = lineEnd + 1;
+
+            if (line.empty() || line.front() == '#' || line.front() == ';') { continue; }
+            if (line.front() == '[' && line.back() == ']') {
+                section = &sections_[trim(line.substr(1, line.size() - 2))];
+                continue;
+            }
+
+            auto equalPos = line.find('=');
+            if (equalPos == std::string_view::npos) { continue; }
+            auto key = trim(line.substr(0, equalPos));
+            if (key.empty()) { continue; }
+            (*section)[key] = unquote(trim(line.substr(equalPos + 1)));
+        }
+    }
+
+    bool map(const char *path) {
+#ifdef _WIN32
+        std::FILE *file = std::fopen(path, "rb");
+        if (file == nullptr) { return false; }
+        bool ok   = std::fseek(file, 0, SEEK_END) == 0;
+        long size = ok ? std::ftell(file) : -1;
+        ok        = size >= 0 && std::fseek(file, 0, SEEK_SET) == 0;
+        if (ok && size > 0) {
+            buffer_.reset(new char[size]);
+            ok = std::fread(buffer_.get(), 1, size, file) == static_cast<size_t>(size);
+        }
+        std::fclose(file);
+        if (!ok) {
+            buffer_.reset();
+            return false;
+        }
+        data_ = buffer_.get();
+        size_ = static_cast<size_t>(size);
+        return true;
+#else
+        int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) { return false; }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+            ::close(fd);
+            return false;
+        }
+        if (st.st_size > 0) {
+            void *addr = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                return false;
+            }
+            data_ = static_cast<const char *>(addr);
+            size_ = static_cast<size_t>(st.st_size);
+        }
+        // The mapping stays valid after the descriptor is closed
+        ::close(fd);
+        return true;
+#endif
+    }
+
+    void swap(ConfigFile &other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+#ifdef _WIN32
+        std::swap(buffer_, other.buffer_);
+#endif
+        std::swap(path_, other.path_);
+        std::swap(sections_, other.sections_);
+        std::swap(indexed_, other.indexed_);
+        std::swap(isOpen_, other.isOpen_);
+    }
+
+    const char *data_ = nullptr;
+    size_t      size_ = 0;
+#ifdef _WIN32
+    std::unique_ptr<char[]> buffer_;
+#endif
+    std::string                                   path_;
+    std::unordered_map<std::string_view, Section> sections_;
+    bool                                          indexed_ = false;
+    bool                                          isOpen_  = false;
+};
+
+} // namespace ArgLite
@@ -2,23 +2,96 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
-#include <iostream>
+#include <functional>
+#include <memory>
+#ifdef ARGLITE_ENABLE_PMR
+#include <memory_resource>
+#include <new>
+#endif
 #include <optional>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
-#include "Formatter.hpp" // IWYU pragma: keep
+#include "Formatter.hpp"  // IWYU pragma: keep
+#include "OutputSink.hpp" // IWYU pragma: keep
+#ifdef ARGLITE_ENABLE_CONFIG_FILE
+#include "ConfigFile.hpp" // IWYU pragma: keep
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
 
 namespace ArgLite {
 
 class SubParser;
+class ParsedArgs;
+class ConfigReloader;
+class CmdlineView;
+
+/**
+ * @brief Text only used for the help message, such as an option description.
+ * @details A `const char` array is taken for a string literal and kept as a view, which is read when the help
+ *          message is printed in post-processing. The array must have static storage duration, like a literal,
+ *          a global or a `static` local. A non-static local `const char desc[]` dangles by then, pass it as
+ *          `std::string(desc)` instead. Writable buffers and other strings are copied or moved in.
+ */
+class HelpText {
+public:
+    template <size_t N>
+    HelpText(const char (&literal)[N]) : view_(literal, arrayLength(literal, N)) {} // NOLINT(google-explicit-constructor)
+
+    // A writable buffer, e.g., filled by snprintf, may change or go away before the help is rendered
+    template <size_t N>
+    HelpText(char (&buffer)[N]) : owned_(buffer, arrayLength(buffer, N)), isOwned_(true) {} // NOLINT(google-explicit-constructor)
+
+    template <typename T, std::enable_if_t<std::is_same_v<T, const char *> || std::is_same_v<T, char *>, int> = 0>
+    HelpText(const T &str) : owned_(str), isOwned_(true) {} // NOLINT(google-explicit-constructor)
+
+    HelpText(std::string str) : owned_(std::move(str)), isOwned_(true) {} // NOLINT(google-explicit-constructor)
+
+private:
+    friend class Parser;
+
+    HelpText() = default;
+
+    [[nodiscard]]
+    bool empty() const { return isOwned_ ? owned_.empty() : view_.empty(); }
+
+    // The length up to the first null character, the array may be larger than its text
+    static size_t arrayLength(const char *array, size_t size) {
+        const char *end = std::char_traits<char>::find(array, size, '\0');
+        return end == nullptr ? size : static_cast<size_t>(end - array);
+    }
+
+    // Wraps a string with static storage duration without copying it
+    static HelpText fromStatic(std::string_view sv) {
+        HelpText text;
+        text.view_ = sv;
+        return text;
+    }
+
+    std::string_view view_;
+    std::string      owned_;
+    bool             isOwned_{false};
+};
 
 class Parser {
     friend class SubParser;
+    friend class ParsedArgs;
+    friend class ConfigReloader;
+    friend class CmdlineView;
+
+    // C++17 compatible `type_identity_t` (`std::type_identity_t` is C++20)
+    // It prevents a parameter from taking part in template argument deduction
+    template <typename T> struct type_identity { using type = T; };
+    template <typename T>
+    using type_identity_t = typename type_identity<T>::type;
 
 public:
     /**
@@ -29,6 +102,8 @@ public:
 
     /**
      * @brief Sets the program version and add options `-V` and `--version` to print the version.
+     * @details If it is called before `preprocess()`, the version is printed in `preprocess()`
+                without waiting for the other functions.
      * @param versionStr The program's version string.
      */
     static void setVersion(std::string versionStr) { programVersion_ = std::move(versionStr); }
@@ -45,6 +120,110 @@ public:
      */
     static void setShortNonFlagOptsStr(std::string shortNonFlagOptsStr) { mainCmdShortNonFlagOptsStr_ = std::move(shortNonFlagOptsStr); }
 
+    /**
+     * @brief Stops parsing options at the first positional argument, like `POSIXLY_CORRECT` in getopt.
+     * @details It suits wrappers like `env`, `time` or `sudo`, e.g., `tool [opts] cmd args...` or `tool [opts] -- cmd args...`.
+                The first positional argument and everything after it (or everything after `--`) form the tail,
+                which is returned by `getArgvTail()` and is never scanned, so options of the wrapped command stay in it.
+                An option only takes the next argument as its value if it is in `setShortNonFlagOptsStr()`
+                or `setLongNonFlagOpts()`, otherwise it is a flag. Call it before `preprocess()`.
+     * @param enabled True to stop at the first positional argument, false to parse all arguments.
+     */
+    static void setStopAtFirstPositional(bool enabled = true) { stopAtFirstPositional_ = enabled; }
+
+    /**
+     * @brief Sets which long options require a value when `setStopAtFirstPositional()` is enabled.
+     * @details Other long options take a value only in the `--opt=value` form. Call it before `preprocess()`.
+     * @param longNonFlagOpts The long option names without dashes, e.g., `{"signal", "user"}`.
+     */
+    static void setLongNonFlagOpts(std::vector<std::string> longNonFlagOpts) { longNonFlagOpts_ = std::move(longNonFlagOpts); }
+
+    /**
+     * @brief A view of consecutive arguments in argv.
+     */
+    struct ArgvSpan {
+        const char *const *data;
+        size_t             size;
+
+        [[nodiscard]] const char *const *begin() const { return data; }
+        [[nodiscard]] const char *const *end() const { return data + size; }
+        [[nodiscard]] bool               empty() const { return size == 0; }
+        const char                      *operator[](size_t idx) const { return data[idx]; }
+    };
+
+    /**
+     * @brief The values of an option with the argv index of each value, returned by `OptValBuilder::getScoped()`.
+     * @details Used for options that apply to the next anchor, e.g., `-c copy -i a.mp4 -c h264 -i b.mp4`,
+                where the anchors are the occurrences of another option or the positional arguments.
+     */
+    template <typename T>
+    struct ScopedValues {
+        std::vector<T>   values;      // In the argv order
+        std::vector<int> argvIndices; // The argv index of each value
+
+        /**
+         * @brief Groups the values by the anchors in one linear merge.
+         * @details Group `k` holds the values between anchor `k - 1` and anchor `k`,
+                    and the last group holds the values after the last anchor.
+         * @param anchors The sorted argv indices of the anchors, e.g., `argvIndices` of the anchor option
+                          or `Parser::getPositionalArgvIndices()`.
+         * @return `anchors.size() + 2` offsets, the values of group `k` are in `[offsets[k], offsets[k + 1])`.
+         */
+        [[nodiscard]]
+        std::vector<size_t> groupOffsets(const std::vector<int> &anchors) const {
+            std::vector<size_t> offsets;
+            offsets.reserve(anchors.size() + 2);
+            offsets.push_back(0);
+            size_t valueIdx = 0;
+            for (int anchor : anchors) {
+                while (valueIdx < argvIndices.size() && argvIndices[valueIdx] < anchor) { valueIdx++; }
+                offsets.push_back(valueIdx);
+            }
+            offsets.push_back(argvIndices.size());
+            return offsets;
+        }
+    };
+
+    /**
+     * @brief Gets the argv indices of all positional arguments, in order, to be used as anchors of scoped options.
+     * @details Call it after all get/hasFlag calls of options, like the get functions of positional arguments.
+     * @return The argv indices.
+     */
+    [[nodiscard]]
+    static std::vector<int> getPositionalArgvIndices() {
+        fixPositionalArgsArray(data_.positionalArgsIndices, data_.options);
+        return {data_.positionalArgsIndices.begin(), data_.positionalArgsIndices.end()};
+    }
+
+    /**
+     * @brief Gets the arguments after the point where `setStopAtFirstPositional()` stopped the parsing.
+     * @details The span views argv, nothing is copied. As argv from `main()` ends with a null pointer,
+                so does the span, and it can be passed to `execvp(tail[0], const_cast<char *const *>(tail.data))`.
+     * @return The tail of argv, empty if the parsing did not stop early.
+     */
+    [[nodiscard]]
+    static ArgvSpan getArgvTail() { return {argv_ + argvTailIdx_, static_cast<size_t>(argc_ - argvTailIdx_)}; }
+
+    /**
+     * @brief Passes unknown options through instead of reporting them, so they can be forwarded to another program.
+     * @details Post-processing collects them for `getUnknownArgs()` and no longer reports them as errors.
+     * @param enabled True to pass unknown options through, false to report them.
+     */
+    static void setPassThroughUnknown(bool enabled = true) { passThroughUnknown_ = enabled; }
+
+    /**
+     * @brief Gets the arguments of the options that were not processed by get/hasFlag, in the order of argv.
+     * @details Call it after all get/hasFlag calls. A separated value is kept with its option (e.g., `--opt val`),
+                unless a positional argument took it, and a bundle of short options (e.g., `-ab`) is kept as a whole
+                if any of them is unknown. The pointers view argv and stay valid until the next `preprocess()`.
+     * @return The arguments, which can be appended to the argv of a child process.
+     */
+    [[nodiscard]]
+    static const std::vector<const char *> &getUnknownArgs() {
+        collectUnknownArgs(data_);
+        return unknownArgs_;
+    }
+
     /**
      * @brief Preprocesses the command-line arguments. This is the first step in using this library.
      * @param argc The argc from the main function.
@@ -52,15 +231,43 @@ public:
      */
     static void preprocess(int argc, const char *const *argv) { preprocess_(argc, argv); }
 
+#ifdef ARGLITE_ENABLE_PMR
+    /**
+     * @brief Sets the memory resource that backs the containers and strings of the internal data.
+     * @details Call it before `preprocess()`. The resource is used until the end of the parsing,
+                `finalize()` (or `runAllPostprocess()`) switches back to the default resource,
+                so the resource only needs to outlive the parsing.
+     * @param resource The memory resource, e.g., a `std::pmr::monotonic_buffer_resource` with a buffer on the stack.
+     * @param releaseAtOnce If true, the internal data is abandoned at the end of the parsing
+                            instead of being destroyed element by element. Only pass true for resources
+                            that release all memory at once, such as `std::pmr::monotonic_buffer_resource`.
+     */
+    static void setMemoryResource(std::pmr::memory_resource *resource, bool releaseAtOnce = false) {
+        resetData(data_, resource, false);
+        releaseAtOnce_ = releaseAtOnce;
+    }
+#endif
+
+    /**
+     * @brief Checks if the help message is requested (`-h` or `--help` is passed).
+     * @details Available after `preprocess()`. When it is true, the getters only collect declarations
+                for the help message: positional arguments are not collected, and errors are not printed.
+                It can be used to skip expensive setup that is not needed for printing the help message.
+                An option declared as `-h` or `--help` takes precedence, once it is got the flag is updated.
+     * @return True if the help message is requested, false otherwise.
+     */
+    [[nodiscard]]
+    static bool isHelpRequested() { return data_.helpRequested; }
+
     /**
      * @brief Checks if a flag option exists.
      * @param optName The short name, long name, or a comma-separated list of both
                       (e.g., `v`, `verbose` or `v,verbose`).
-     * @param description Option description, used for the help message.
+     * @param description Option description, used for the help message. A `const char` array is not copied (see `HelpText`).
      * @return Returns true if the option appears in the command line, false otherwise.
      */
     [[nodiscard]]
-    static bool hasFlag(std::string_view optName, std::string description) {
+    static bool hasFlag(std::string_view optName, HelpText description) {
         if (!isMainCmdActive()) { return false; }
         return hasFlag_(optName, std::move(description), data_);
     }
@@ -69,11 +276,11 @@ public:
      * @brief Counts the number of times a flag option appears.
      * @param optName The short name, long name, or a comma-separated list of both
                       (e.g., `v`, `verbose` or `v,verbose`).
-     * @param description Option description, used for the help message.
+     * @param description Option description, used for the help message. A `const char` array is not copied (see `HelpText`).
      * @return Returns the number of times the option appears in the command line.
      */
     [[nodiscard]]
-    static unsigned countFlag(std::string_view optName, std::string description) {
+    static unsigned countFlag(std::string_view optName, HelpText description) {
         if (!isMainCmdActive()) { return 0; }
         return countFlag_(optName, std::move(description), data_);
     }
@@ -81,9 +288,9 @@ public:
     //  Structure for arguments of mutually exclusive flag options.
     struct HasMutualExArgs {
         std::string trueOptName;      // Name of the option that represents the true condition.
-        std::string trueDescription;  // Description of the option that represents the true condition.
+        HelpText    trueDescription;  // Description of the option that represents the true condition.
         std::string falseOptName;     // Name of the option that represents the false condition.
-        std::string falseDescription; // Description of the option that represents the false condition.
+        HelpText    falseDescription; // Description of the option that represents the false condition.
         bool        defaultValue;     // Default value if neither option is specified.
     };
 
@@ -106,12 +313,12 @@ public:
      * @brief Creates a builder for a generic typed option.
      * @tparam T Target type to which the option value will be parsed.
      * @param optName The short name, long name, or a comma-separated list of both
-     * @param description Option description, used for the help message.
+     * @param description Option description, used for the help message. A `const char` array is not copied (see `HelpText`).
      * @return An `OptValBuilder` object that can be used to parse the option value.
      */
     template <typename T>
     [[nodiscard]]
-    static OptValBuilder<T> get(std::string_view optName, std::string description) {
+    static OptValBuilder<T> get(std::string_view optName, HelpText description) {
         // This class is responsible for checking the currently active command
         return OptValBuilder<T>(optName, std::move(description), data_, nullptr);
     }
@@ -134,7 +341,30 @@ public:
         bool required = true, std::string defaultValue = "") {
 
         if (!isMainCmdActive()) { return ""; }
-        return getPositional_(posName, std::move(description), required, std::move(defaultValue), data_);
+        return getPositional_<std::string>(posName, std::move(description), required, std::move(defaultValue), data_);
+    }
+
+    /**
+     * @brief Gets a positional argument and converts it to type T.
+     * @details The same as `getPositional()`, but the argument is converted like an option value.
+                An invalid value is reported as an error.
+     * @tparam T Target type to which the argument will be parsed.
+     * @param name Argument name, used for the help message (e.g., "count").
+     * @param description Positional argument description, used for the help message.
+     * @param required If true and the user does not provide the argument,
+                       the program will report an error and exit.
+     * @param defaultValue The default value to return if the argument
+                            is not provided and not required.
+     * @return The converted value of the argument, or the default value if it is not provided or invalid.
+     */
+    template <typename T>
+    [[nodiscard]]
+    static T getPositional(
+        const std::string &posName, std::string description,
+        bool required = true, type_identity_t<T> defaultValue = T()) {
+
+        if (!isMainCmdActive()) { return defaultValue; }
+        return getPositional_<T>(posName, std::move(description), required, std::move(defaultValue), data_);
     }
 
     /**
@@ -154,15 +384,59 @@ public:
         bool required = true, const std::vector<std::string> &defaultValue = {}) {
 
         if (!isMainCmdActive()) { return {}; }
-        return getRemainingPositionals_(posName, description, required, defaultValue, data_);
+        return getRemainingPositionals_<std::string>(posName, description, required, defaultValue, data_);
+    }
+
+    /**
+     * @brief Gets all remaining positional arguments and converts them to type T.
+     * @details The same as `getRemainingPositionals()`, but the arguments are converted like option values.
+                Invalid values are reported as errors and skipped.
+     * @tparam T Target type to which the arguments will be parsed.
+     * @param name Argument name, used for the help message (e.g., "ids").
+     * @param description Positional arguments description, used for the help message.
+     * @param required If true and there are no remaining arguments,
+                       the program will report an error and exit.
+     * @param defaultValue The default value to return if the argument
+                            is not provided and not required.
+     * @return A vector containing all converted remaining arguments.
+     */
+    template <typename T>
+    [[nodiscard]]
+    static std::vector<T> getRemainingPositionals(
+        const std::string &posName, std::string description,
+        bool required = true, const std::vector<type_identity_t<T>> &defaultValue = {}) {
+
+        if (!isMainCmdActive()) { return {}; }
+        return getRemainingPositionals_<T>(posName, std::move(description), required, defaultValue, data_);
+    }
+
+    /**
+     * @brief Gets all remaining positional arguments by permuting argv in place, like GNU getopt.
+     * @details Options and their values are moved to the front, keeping their order, and positional arguments
+                to the end. Call it after all get/hasFlag calls, instead of `getRemainingPositionals()`.
+                No string is copied, the span views argv, and the errors and unknown options refer to the new order.
+                The permutation is linear, with a scratch buffer of pointers kept in the internal data.
+     * @param argv The argv passed to `preprocess()`, which is permuted.
+     * @param name Argument name, used for the help message (e.g., "extra-files").
+     * @param description Positional arguments description, used for the help message.
+     * @param required If true and there are no remaining arguments,
+                       the program will report an error and exit.
+     * @return The remaining arguments, at the end of argv.
+     */
+    [[nodiscard]]
+    static ArgvSpan getRemainingPositionalsInPlace(
+        char **argv, const std::string &posName, std::string description, bool required = true) {
+
+        if (!isMainCmdActive()) { return {}; }
+        return getRemainingPositionalsInPlace_(argv, posName, std::move(description), required, data_);
     }
 
     /**
      * @brief Inserts a custom option header to the help message.
      * @details See the README for details.
-     * @param header The option header text.
+     * @param header The option header text. A `const char` array is not copied (see `HelpText`).
      */
-    static void insertOptHeader(std::string header) {
+    static void insertOptHeader(HelpText header) {
         if (!isMainCmdActive()) { return; }
         insertOptHeader_(std::move(header));
     }
@@ -174,7 +448,63 @@ public:
      */
     static void pushBackErrorMsg(std::string msg) {
         if (!isMainCmdActive()) { return; }
-        data_.errorMessages.push_back(std::move(msg));
+        pushCustomError(std::move(msg));
+    }
+
+    /**
+     * @brief Kind of a parsing error.
+     */
+    enum class ErrorCode : unsigned char {
+        InvalidValue,       // The value of an option cannot be converted
+        InvalidEnvValue,    // The environment variable of an option cannot be converted
+        InvalidConfigValue, // The config file value of an option cannot be converted
+        MissingValue,       // An option is passed without a value
+        MissingOption,      // A required option is not passed
+        InvalidPositional,  // A positional argument cannot be converted
+        MissingPositional,  // A required positional argument is not passed
+        DuplicateKey,       // A key of a map option is passed more than once
+        Custom,             // Inserted by `pushBackErrorMsg()`
+    };
+
+    /**
+     * @brief What `OptValBuilder::getMap()` does when a key is passed more than once.
+     */
+    enum class DuplicateKeyPolicy : unsigned char {
+        LastWins, // The last value of the key is kept
+        Error,    // Each repeated key is reported as an error, the last value is kept
+    };
+
+    /**
+     * @brief A parsing error. The message is only rendered when it is printed or `errorToString()` is called.
+     */
+    struct ParseError {
+        ErrorCode        code;
+        std::uint32_t    handle;    // Index of the help entry of the option or positional argument,
+                                    // or of the custom message
+        int              argvIndex; // Index of the offending argument in argv, -1 if there is none
+        std::string_view value;     // The offending value, it views argv
+        std::string_view typeName;  // The expected type for invalid values
+    };
+
+    /**
+     * @brief Gets the errors recorded so far by the get functions and `pushBackErrorMsg()`.
+     * @details Valid until `finalize()` (or `runAllPostprocess()`) clears the internal data.
+     * @return The errors in the order they were recorded.
+     */
+    [[nodiscard]]
+    static const auto &getErrors() { return data_.errors; }
+
+    /**
+     * @brief Renders the message of an error without ANSI sequences, as it is printed by `finalize()`.
+     * @details Valid until `finalize()` (or `runAllPostprocess()`) clears the internal data.
+     * @param error An error returned by `getErrors()`.
+     * @return The error message.
+     */
+    [[nodiscard]]
+    static std::string errorToString(const ParseError &error) {
+        std::string out;
+        appendErrorMsg(out, error, data_, OutputSink::string(out));
+        return out;
     }
 
     /**
@@ -187,6 +517,18 @@ public:
         data_.helpFooter = footer;
     }
 
+    /**
+     * @brief Sets where the help, version and error messages are written. Default is stdout and stderr.
+     * @details Each message is rendered into one buffer and written to the sink at once.
+                ANSI sequences are only used for sinks connected to a terminal.
+     * @param out The sink for the help and version messages.
+     * @param err The sink for the error messages.
+     */
+    static void setOutput(OutputSink out, OutputSink err) {
+        outSink_ = out;
+        errSink_ = err;
+    }
+
     /**
      * @brief Changes the description indent of option descriptions in the help message. Default is 25.
      * @details This function should be called before tryToPrintHelp.
@@ -226,6 +568,85 @@ public:
      */
     static bool runAllPostprocess(bool notExit = false) { return runAllPostprocess_(data_, notExit); }
 
+    /**
+     * @brief How the parsing of a command line ended.
+     */
+    enum class ParseStatus : unsigned char {
+        Ok,             // The values are ready to use
+        HelpPrinted,    // -h or --help was passed, the help message was printed
+        VersionPrinted, // -V or --version was passed, the version was printed
+        Error,          // Unknown options or errors were printed
+    };
+
+    /**
+     * @brief Enables the embedded mode, in which the parser never exits the program.
+     * @details It suits parsing many command lines in one process, e.g., commands sent to a server.
+                Help, version and errors are printed and reported by `postprocess()` instead,
+                and the internal containers keep their memory for the next command line.
+                Misuses of the library, e.g., an empty option name, are reported as errors.
+     * @param embedded True to enable the embedded mode, false to disable it.
+     */
+    static void setEmbeddedMode(bool embedded = true) { embedded_ = embedded; }
+
+    /**
+     * @brief Runs tryToPrintHelp, tryToPrintInvalidOpts, and finalize in sequence, and reports how the parsing ended.
+     * @details Only the help or the version is printed if it is requested, unknown options and errors
+                are not reported then. In the embedded mode, the program is never exited.
+                Otherwise, it exits after printing the help or the version like `runAllPostprocess()`.
+     * @return The status of the parsing.
+     */
+    static ParseStatus postprocess() { return postprocess_(data_); }
+
+    /**
+     * @brief Records the values returned by the get functions, so that `snapshot()` can collect them.
+     * @details Call it before the get functions. Values are not recorded by default.
+     * @param enabled True to record the values, false to stop recording.
+     */
+    static void setSnapshotEnabled(bool enabled = true) { snapshotEnabled_ = enabled; }
+
+    /**
+     * @brief Collects the values recorded so far into an immutable snapshot.
+     * @details Call it after the get functions and before `finalize()` (or `runAllPostprocess()`),
+                which clears the recorded values. The snapshot owns a copy of everything it needs.
+     * @return The snapshot, which can be shared by pointer and read from many threads without locking.
+     */
+    [[nodiscard]]
+    static std::shared_ptr<const ParsedArgs> snapshot() { return snapshot_(data_); }
+
+    /**
+     * @brief Sets the prefix of the environment variables that options with a value fall back to.
+     * @details An option with a long name falls back to the prefix followed by the long name in upper case
+                with `-` replaced by `_`, e.g., `APP_MAX_THREADS` for `--max-threads` with the prefix `APP_`.
+                The precedence is command line > environment variable > default value.
+                The environment is scanned once and indexed by the variables with the prefix.
+     * @param prefix The prefix of the variable names. If it is empty, only `env()` names are used.
+     */
+    static void setEnvPrefix(std::string prefix) {
+        envPrefix_  = std::move(prefix);
+        envIndexed_ = false;
+    }
+
+#ifdef ARGLITE_ENABLE_CONFIG_FILE
+    /**
+     * @brief Loads a config file that fills the options with a value not passed on the command line.
+     * @details The keys are the long option names without dashes, e.g., `threads = 4` for `--threads`.
+                Keys before the first section belong to the main command, `[name]` starts the section
+                of the subcommand `name`. The precedence is command line > environment variable > config file > default value.
+                The file is memory-mapped and only tokenized at the first lookup, values are converted from views of the mapping.
+                A `std::string_view` value taken from the file is a view of the mapping, and dangles once the file is
+                closed or another file is loaded, e.g., by `ConfigReloader::reload()`. Use `std::string` to keep it.
+     * @param path The path of the file, the previous file is closed.
+     * @return True if the file is loaded, false if it cannot be opened.
+     */
+    static bool loadConfigFile(std::string path) { return config_.open(std::move(path)); }
+
+    /**
+     * @brief Closes the config file, options fall back to the default values again.
+     * @details `std::string_view` values taken from the file dangle after this call.
+     */
+    static void closeConfigFile() { config_.close(); }
+#endif
+
     Parser() = delete;
 
     // === SubParser Instance-related Methods ===
@@ -245,116 +666,298 @@ private:
 
     // === Static-related ===
 
+#ifdef ARGLITE_ENABLE_PMR
+    // Containers and strings of InternalData allocate from the memory resource set by `setMemoryResource()`
+    using String = std::pmr::string;
+    template <typename T>
+    using Vector = std::pmr::vector<T>;
+#else
+    using String = std::string;
+    template <typename T>
+    using Vector = std::vector<T>;
+#endif
+
     // Stores option information for subsequent get/hasFlag calls.
     // key: Option name (e.g., "-o", "--output").
     // value: index > 0: Index of the argument in argv;
     // index < 0: Index of the flag option in argv;
     // index == 0: Default value, no special meaning yet.
+    // The value is a slice of argv[argvIndex], so nothing is copied.
+    // valueOffset > 0 means the value is inside the option argument (-n123 and --opt=val forms).
     struct OptionInfo {
-        int         argvIndex;
-        std::string valueStr; // Only used for -n123 and --opt=val forms
+        int           argvIndex;
+        std::uint32_t valueOffset;
+        std::uint32_t valueLength;
+    };
+
+    // The occurrences of an option. A single occurrence is stored inline,
+    // and the heap is only used when the option is repeated.
+    class OptionInfoArr {
+    public:
+#ifdef ARGLITE_ENABLE_PMR
+        // Constructed with the allocator of the options map
+        using allocator_type = std::pmr::polymorphic_allocator<OptionInfo>;
+
+        OptionInfoArr() = default;
+        explicit OptionInfoArr(const allocator_type &alloc) : repeated_(alloc) {}
+#endif
+
+        void push_back(const OptionInfo &optInfo) {
+            if (size_ == 1) {
+                repeated_.reserve(2);
+                repeated_.push_back(single_);
+            }
+            if (size_ == 0) {
+                single_ = optInfo;
+            } else {
+                repeated_.push_back(optInfo);
+            }
+            size_++;
+        }
+
+        [[nodiscard]] size_t size() const { return size_; }
+        [[nodiscard]] bool   empty() const { return size_ == 0; }
+
+        OptionInfo       *begin() { return size_ <= 1 ? &single_ : repeated_.data(); }
+        OptionInfo       *end() { return begin() + size_; }
+        const OptionInfo *begin() const { return size_ <= 1 ? &single_ : repeated_.data(); }
+        const OptionInfo *end() const { return begin() + size_; }
+
+        OptionInfo       &operator[](size_t idx) { return begin()[idx]; }
+        const OptionInfo &operator[](size_t idx) const { return begin()[idx]; }
+        OptionInfo       &back() { return begin()[size_ - 1]; }
+        const OptionInfo &back() const { return begin()[size_ - 1]; }
+
+    private:
+        OptionInfo         single_{};
+        Vector<OptionInfo> repeated_;
+        size_t             size_ = 0;
+    };
+
+    // A string in an option help entry.
+    // It views a string literal if `literal` is not null, otherwise it is a slice of `helpArena`.
+    struct HelpStr {
+        const char   *literal;
+        std::uint32_t offset;
+        std::uint32_t size;
     };
 
     struct OptionHelpInfo {
-        std::string shortOpt; // Prepended with "-"
-        std::string longOpt;  // Prepended with "--"
-        std::string description;
-        std::string defaultValue;
-        std::string typeName;
-        bool        isRequired;
-        bool        isMutualExDefault;
-        bool        isOptHeader; // The first member (shortOpt) will be an option header if it is true
+        HelpStr shortOpt; // Prepended with "-"
+        HelpStr longOpt;  // Prepended with "--"
+        HelpStr description;
+        HelpStr defaultValue;
+        HelpStr typeName;
+        HelpStr envName; // The environment variable the option falls back to
+        bool    isRequired;
+        bool    isMutualExDefault;
+        bool    isOptHeader; // The first member (shortOpt) will be an option header if it is true
+    };
+
+    // A slice of a text buffer
+    struct TextSlice {
+        std::uint32_t offset;
+        std::uint32_t size;
+    };
+
+    // The result of a get function recorded for `snapshot()`, the slices refer to `snapshotText`
+    struct SnapshotItem {
+        TextSlice     shortName;  // Without "-"
+        TextSlice     longName;   // Without "--", or the positional name
+        unsigned      count;      // Occurrences on the command line
+        std::uint32_t firstValue; // Index of the first value in `snapshotValues`
+        std::uint32_t valueCount;
     };
 
     struct PositionalHelpInfo {
-        std::string name;
-        std::string description;
-        std::string defaultValue;
-        bool        isRequired;
-        bool        isRemaining;
+        HelpStr name;
+        HelpStr description;
+        HelpStr defaultValue;
+        bool    isRequired;
+        bool    isRemaining;
     };
 
-    using OptMap = std::unordered_map<std::string, std::vector<OptionInfo>>;
+#ifdef ARGLITE_ENABLE_PMR
+    using OptMap = std::pmr::unordered_map<String, OptionInfoArr>;
+#else
+    using OptMap = std::unordered_map<String, OptionInfoArr>;
+#endif
 
     struct InternalData {
-        std::string      cmdName;
+#ifdef ARGLITE_ENABLE_PMR
+        InternalData() : InternalData(std::pmr::get_default_resource()) {}
+        explicit InternalData(std::pmr::memory_resource *resource)
+            : cmdName(resource), positionalIdx(0), hasCustumOptHeader(false), helpRequested(false),
+              options(resource), optionHelpEntries(resource), positionalArgsIndices(resource),
+              positionalHelpEntries(resource), errors(resource), customErrorMessages(resource), helpArena(resource),
+              snapshotItems(resource), snapshotValues(resource), snapshotText(resource), permuteBuffer(resource) {}
+#endif
+
+        String           cmdName;
         std::string_view helpFooter;
         size_t           positionalIdx;
         bool             hasCustumOptHeader;
+        bool             helpRequested; // -h or --help is passed, detected in preprocess
         // Containers
-        OptMap                          options;
-        std::vector<OptionHelpInfo>     optionHelpEntries;
-        std::vector<int>                positionalArgsIndices;
-        std::vector<PositionalHelpInfo> positionalHelpEntries;
-        std::vector<std::string>        errorMessages;
+        OptMap                     options;
+        Vector<OptionHelpInfo>     optionHelpEntries;
+        Vector<int>                positionalArgsIndices;
+        Vector<PositionalHelpInfo> positionalHelpEntries;
+        Vector<ParseError>         errors;
+        Vector<String>             customErrorMessages; // Messages of `ErrorCode::Custom` errors
+        String                     helpArena; // Storage of owned strings in help entries
+        Vector<SnapshotItem>       snapshotItems;
+        Vector<TextSlice>          snapshotValues;
+        String                     snapshotText; // Names and values of the snapshot items
+        Vector<char *>             permuteBuffer; // Positional arguments moved by `permuteArgv()`
     };
 
     // Internal data storage
     static inline int                argc_;
     static inline const char *const *argv_;
+    static inline int                argvTailIdx_; // Index of the first argument of the tail, argc_ if there is none
+    static inline std::vector<const char *> unknownArgs_;
 
     static inline size_t       descriptionIndent_ = 25; // NOLINT(readability-magic-numbers)
+    static inline OutputSink   outSink_           = OutputSink::fd(1);
+    static inline OutputSink   errSink_           = OutputSink::fd(2);
     static inline std::string  programDescription_;
     static inline std::string  programVersion_;
     static inline std::string  mainCmdShortNonFlagOptsStr_;
+    static inline bool         stopAtFirstPositional_ = false;
+    static inline std::vector<std::string> longNonFlagOpts_;
+    static inline bool         passThroughUnknown_ = false;
     static inline InternalData data_;
+    static inline bool         embedded_          = false;
+    static inline bool         snapshotEnabled_   = false;
+    static inline std::string  envPrefix_;
+    static inline bool         envIndexed_        = false;
+    // Views of the `NAME=value` strings in the environment with the prefix
+    static inline std::unordered_map<std::string_view, std::string_view> envIndex_;
+#ifdef ARGLITE_ENABLE_CONFIG_FILE
+    static inline ConfigFile config_;
+    // A parse runs from preprocess() to post-processing, ConfigReloader may run one on another thread
+    static inline std::mutex              parseMutex_;
+    static inline std::condition_variable parseDone_;
+    static inline std::thread::id         parseOwner_;
+    static inline bool                    parsePinned_ = false; // Post-processing does not unlock it
+#endif
+#ifdef ARGLITE_ENABLE_PMR
+    static inline bool releaseAtOnce_ = false;
+#endif
 
     class OptValHelper;
 
     // Internal helper functions
     // Get functions, internal data can be changed
-    static inline bool                     hasFlag_(std::string_view optName, std::string description, InternalData &data);
-    static inline unsigned                 countFlag_(std::string_view optName, std::string description, InternalData &data);
+    static inline bool                     hasFlag_(std::string_view optName, HelpText description, InternalData &data);
+    static inline unsigned                 countFlag_(std::string_view optName, HelpText description, InternalData &data);
     static inline bool                     hasMutualExFlag_(HasMutualExArgs args, InternalData &data);
-    static inline std::string              getPositional_(const std::string &posName, std::string description, bool required, std::string defaultValue, InternalData &data);
-    static inline std::vector<std::string> getRemainingPositionals_(const std::string &posName, std::string description, bool isRequired, const std::vector<std::string> &defaultValue, InternalData &data);
+    template <typename T> static inline T              getPositional_(const std::string &posName, std::string description, bool required, T defaultValue, InternalData &data);
+    template <typename T> static inline std::vector<T> getRemainingPositionals_(const std::string &posName, std::string description, bool isRequired, const std::vector<T> &defaultValue, InternalData &data);
+    static inline ArgvSpan getRemainingPositionalsInPlace_(char **argv, const std::string &posName, std::string description, bool isRequired, InternalData &data);
+    static inline void     permuteArgv(char **argv, InternalData &data);
     // Helper functions for get functions
-    static inline void restorePosArgsInFlags(const std::vector<OptionInfo> &optInfoArr, std::vector<int> &positionalArgsIndices);
-    static inline void appendPosValErrorMsg(InternalData &data, std::string_view posName, std::string errorMsg);
-    static inline void fixPositionalArgsArray(std::vector<int> &positionalArgsIndices, OptMap &options);
+    static inline void restorePosArgsInFlags(const OptionInfoArr &optInfoArr, Vector<int> &positionalArgsIndices);
+    static inline void appendPosValErrorMsg(InternalData &data);
+    static inline void appendPosConvErrorMsg(InternalData &data, int argvIndex, std::string_view typeName);
+    static inline void pushError(InternalData &data, const ParseError &error);
+    static inline void fixPositionalArgsArray(Vector<int> &positionalArgsIndices, OptMap &options);
+    static inline void indexEnv();
+    static inline std::optional<std::string_view> lookupEnv(std::string_view name);
     // Helper functions for get functions with long return types
     static inline std::string                         parseOptName(std::string_view optName);
     static inline std::pair<std::string, std::string> parseOptNameAsPair(std::string_view optName);
-    static inline OptMap::node_type                   findOption(const std::string &shortOpt, const std::string &longOpt, InternalData &data);
+    static inline OptMap::node_type                   extractOption(const std::string &optName, InternalData &data);
     // Template helper functions for get functions
     template <typename T> struct isOptionalType : public std::false_type {};
     template <typename T> struct isOptionalType<std::optional<T>> : public std::true_type {};
-    template <typename T> static inline T           convertType(const std::string &valueStr);
+    template <typename T> static inline bool        convertType(std::string_view valueStr, T &result);
+    template <typename T> static inline bool        parseNumber(std::string_view valueStr, T &result, int base = 10);
     template <typename T> static inline std::string toString(const T &val);
-    template <typename T> static inline std::string getTypeName();
+    template <typename T> static inline std::string_view getTypeName();
     // C++11/14/17 compatible `remove_cvref_t` (`std::remove_cvref_t` is C++20)
     // This alias removes const, volatile qualifiers and references from a type T
     template <typename T>
     using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<T>>;
     // Pre/Post process functions
     static inline void preprocess_(int argc, const char *const *argv);
-    static inline void tryToPrintVersion_(InternalData &data);
-    static inline void tryToPrintHelp_(InternalData &data);
+    static inline bool        tryToPrintVersion_(InternalData &data);
+    static inline ParseStatus tryToPrintHelp_(InternalData &data);
     static inline bool tryToPrintInvalidOpts_(InternalData &data, bool notExit = false);
+    static inline void collectUnknownArgs(InternalData &data);
     static inline void printHelp(const InternalData &data);
-    static inline void printHelpDescription(std::string_view description);
-    static inline void printHelpUsage(const InternalData &data, std::string_view cmdName);
-    static inline void printHelpSubCmd(const std::vector<SubParser *> &subCmdPtrs);
-    static inline void printHelpPositional(const InternalData &data);
-    static inline void printHelpOptions(const InternalData &data);
+    static inline void renderHelp(const InternalData &data, std::string &out);
+    static inline void renderHelpDescription(std::string &out, std::string_view description);
+    static inline void renderHelpUsage(std::string &out, const InternalData &data, std::string_view cmdName);
+    static inline void renderHelpSubCmd(std::string &out, const std::vector<SubParser *> &subCmdPtrs);
+    static inline void renderHelpPositional(std::string &out, const InternalData &data);
+    static inline void renderHelpOptions(std::string &out, const InternalData &data);
     static inline void clearData(InternalData &data);
+    static inline bool usesCustomResource(const InternalData &data);
+    // Snapshot functions
+    static inline bool                              isRecording();
+    static inline void                              recordOption(InternalData &data, std::string_view shortOpt, std::string_view longOpt, unsigned count);
+    static inline void                              recordItem(InternalData &data, std::string_view shortName, std::string_view longName, unsigned count);
+    static inline void                              recordValue(InternalData &data, std::string_view value);
+    template <typename T> static inline void        recordValueOf(InternalData &data, const T &value);
+    static inline std::shared_ptr<const ParsedArgs> snapshot_(const InternalData &data);
+#ifdef ARGLITE_ENABLE_PMR
+    static inline void resetData(InternalData &data, std::pmr::memory_resource *resource, bool abandon);
+#endif
+    static inline String newString(std::string_view sv, const InternalData &data);
+    static inline void appendErrorMsg(std::string &out, const ParseError &error, const InternalData &data, const OutputSink &sink);
     static inline bool finalize_(InternalData &data, bool notExit = false);
     static inline bool runAllPostprocess_(InternalData &data, bool notExit = false);
-    static inline void printWithIndent(std::string_view sv, int indent, bool indentFirstLine = false);
+    static inline ParseStatus postprocess_(InternalData &data);
+    static inline void appendPadding(std::string &out, size_t length, size_t width);
+    static inline void appendWithIndent(std::string &out, std::string_view sv, size_t indent, bool indentFirstLine = false);
+    // Help entry functions
+    static inline HelpStr          storeHelpStr(HelpText text, InternalData &data);
+    static inline HelpStr          copyHelpStr(std::string_view sv, InternalData &data);
+    static inline std::string_view viewHelpStr(const HelpStr &str, const InternalData &data);
+    static inline void             pushOptionHelp(InternalData &data, std::string_view shortOpt, std::string_view longOpt,
+                                                  HelpText description, HelpText defaultValue = HelpText(), HelpText typeName = HelpText(),
+                                                  bool isRequired = false, bool isMutualExDefault = false, HelpText envName = HelpText());
     // Other functions
-    static void insertOptHeader_(std::string header) {
-        data_.hasCustumOptHeader = true;
-        data_.optionHelpEntries.push_back({std::move(header), "", "", "", "", false, false, true});
+
+    // Waits for a parse of another thread to end, a thread may start its next parse without finishing the last
+    static void lockParse([[maybe_unused]] bool pin = false) {
+#ifdef ARGLITE_ENABLE_CONFIG_FILE
+        std::unique_lock<std::mutex> lock(parseMutex_);
+        auto                         self = std::this_thread::get_id();
+        parseDone_.wait(lock, [self]() { return parseOwner_ == std::thread::id() || parseOwner_ == self; });
+        parseOwner_ = self;
+        if (pin) { parsePinned_ = true; }
+#endif
     }
 
-    // Formatter-related
-#ifdef ARGLITE_ENABLE_FORMATTER
-    constexpr static int            ANSI_CODE_LENGTH = 8; // 4 + 4 (\x1b[1m + \x1b[0m))
-    static inline const std::string ERROR_STR        = Formatter::red("Error: ");
-#else
-    constexpr static int            ANSI_CODE_LENGTH = 0;
-    static inline const std::string ERROR_STR        = "Error: ";
+    static void unlockParse([[maybe_unused]] bool unpin = false) {
+#ifdef ARGLITE_ENABLE_CONFIG_FILE
+        std::lock_guard<std::mutex> lock(parseMutex_);
+        if (parseOwner_ != std::this_thread::get_id()) { return; }
+        if (unpin) {
+            parsePinned_ = false;
+        } else if (parsePinned_) {
+            return;
+        }
+        parseOwner_ = std::thread::id();
+        parseDone_.notify_all();
 #endif
+    }
+
+    static void pushCustomError(std::string msg) {
+        auto handle = static_cast<std::uint32_t>(data_.customErrorMessages.size());
+        data_.customErrorMessages.emplace_back(std::move(msg));
+        data_.errors.push_back({ErrorCode::Custom, handle, -1, {}, {}});
+    }
+
+    static void insertOptHeader_(HelpText header) {
+        data_.hasCustumOptHeader = true;
+        HelpStr empty{};
+        data_.optionHelpEntries.push_back({storeHelpStr(std::move(header), data_), empty, empty, empty, empty, empty, false, false, true});
+    }
+
 }; // class Parser
 
 class SubParser {
@@ -365,11 +968,14 @@ public:
         : subCommandName_(std::move(subCommandName)),
           subCmdDescription_(std::move(subCmdDescription)) {
 
-        if (std::find_if(Parser::subCmdPtrs_.begin(), Parser::subCmdPtrs_.end(), [subCommandName](const SubParser *p) {
-                return p->subCommandName_ == subCommandName;
+        if (std::find_if(Parser::subCmdPtrs_.begin(), Parser::subCmdPtrs_.end(), [this](const SubParser *p) {
+                return p->subCommandName_ == subCommandName_;
             }) != Parser::subCmdPtrs_.end()) {
-            std::cerr << "[ArgLite] You cannot create multiple SubParser objects with the same subcommand name.\n";
-            std::cerr << "[ArgLite] This subcommand name is already used: " << subCommandName_ << "\n";
+            Parser::errSink_.write("[ArgLite] You cannot create multiple SubParser objects with the same subcommand name.\n"
+                                   "[ArgLite] This subcommand name is already used: " +
+                                   subCommandName_ + "\n");
+            // The subcommand is not registered, so it is never active
+            if (Parser::embedded_) { return; }
             std::exit(EXIT_FAILURE);
         }
 
@@ -401,11 +1007,11 @@ public:
     /**
      * @brief Checks if a flag option exists.
      * @param optName The short name, long name, or a comma-separated list of both (e.g., "v", "verbose" or "v,verbose").
-     * @param description Option description, used for the help message.
+     * @param description Option description, used for the help message. A `const char` array is not copied (see `HelpText`).
      * @return Returns true if the option appears in the command line, false otherwise.
      */
     [[nodiscard]]
-    bool hasFlag(std::string_view optName, std::string description) const {
+    bool hasFlag(std::string_view optName, HelpText description) const {
         if (!isActive()) { return false; }
         return Parser::hasFlag_(optName, std::move(description), Parser::data_);
     }
@@ -413,11 +1019,11 @@ public:
     /**
      * @brief Counts the number of times a flag option appears.
      * @param optName The short name, long name, or a comma-separated list of both (e.g., "v", "verbose" or "v,verbose").
-     * @param description Option description, used for the help message.
+     * @param description Option description, used for the help message. A `const char` array is not copied (see `HelpText`).
      * @return Returns the number of times the option appears in the command line.
      */
     [[nodiscard]]
-    unsigned countFlag(std::string_view optName, std::string description) const {
+    unsigned countFlag(std::string_view optName, HelpText description) const {
         if (!isActive()) { return 0; }
         return Parser::countFlag_(optName, std::move(description), Parser::data_);
     }
@@ -438,12 +1044,12 @@ public:
      * @brief Creates a builder for a generic typed option.
      * @tparam T Target type to which the option value will be parsed.
      * @param optName The short name, long name, or a comma-separated list of both (e.g., "n", "count" or "n,count").
-     * @param description Option description, used for the help message.
+     * @param description Option description, used for the help message. A `const char` array is not copied (see `HelpText`).
      * @return An `OptValBuilder` object that can be used to parse the option value.
      */
     template <typename T>
     [[nodiscard]]
-    Parser::OptValBuilder<T> get(std::string_view optName, std::string description) const {
+    Parser::OptValBuilder<T> get(std::string_view optName, HelpText description) const {
         // This class is responsible for checking the currently active command
         return Parser::OptValBuilder<T>(optName, std::move(description), Parser::data_, this);
     }
@@ -465,7 +1071,30 @@ public:
         bool required = true, std::string defaultValue = "") const {
 
         if (!isActive()) { return ""; }
-        return Parser::getPositional_(posName, std::move(description), required, std::move(defaultValue), Parser::data_);
+        return Parser::getPositional_<std::string>(posName, std::move(description), required, std::move(defaultValue), Parser::data_);
+    }
+
+    /**
+     * @brief Gets a positional argument and converts it to type T.
+     * @details The same as `getPositional()`, but the argument is converted like an option value.
+                An invalid value is reported as an error.
+     * @tparam T Target type to which the argument will be parsed.
+     * @param name Argument name, used for the help message (e.g., "count").
+     * @param description Positional argument description, used for the help message.
+     * @param required If true and the user does not provide the argument,
+                       the program will report an error and exit.
+     * @param defaultValue The default value to return if the argument
+                            is not provided and not required.
+     * @return The converted value of the argument, or the default value if it is not provided or invalid.
+     */
+    template <typename T>
+    [[nodiscard]]
+    T getPositional(
+        const std::string &posName, std::string description,
+        bool required = true, Parser::type_identity_t<T> defaultValue = T()) const {
+
+        if (!isActive()) { return defaultValue; }
+        return Parser::getPositional_<T>(posName, std::move(description), required, std::move(defaultValue), Parser::data_);
     }
 
     /**
@@ -485,15 +1114,56 @@ public:
         bool required = true, const std::vector<std::string> &defaultValue = {}) const {
 
         if (!isActive()) { return {}; }
-        return Parser::getRemainingPositionals_(posName, std::move(description), required, defaultValue, Parser::data_);
+        return Parser::getRemainingPositionals_<std::string>(posName, std::move(description), required, defaultValue, Parser::data_);
+    }
+
+    /**
+     * @brief Gets all remaining positional arguments and converts them to type T.
+     * @details The same as `getRemainingPositionals()`, but the arguments are converted like option values.
+                Invalid values are reported as errors and skipped.
+     * @tparam T Target type to which the arguments will be parsed.
+     * @param name Argument name, used for the help message (e.g., "ids").
+     * @param description Positional arguments description, used for the help message.
+     * @param required If true and there are no remaining arguments,
+                       the program will report an error and exit.
+     * @param defaultValue The default value to return if the argument
+                            is not provided and not required.
+     * @return A vector containing all converted remaining arguments.
+     */
+    template <typename T>
+    [[nodiscard]]
+    std::vector<T> getRemainingPositionals(
+        const std::string &posName, std::string description,
+        bool required = true, const std::vector<Parser::type_identity_t<T>> &defaultValue = {}) const {
+
+        if (!isActive()) { return {}; }
+        return Parser::getRemainingPositionals_<T>(posName, std::move(description), required, defaultValue, Parser::data_);
+    }
+
+    /**
+     * @brief Gets all remaining positional arguments by permuting argv in place, like GNU getopt.
+     * @details The same as `Parser::getRemainingPositionalsInPlace()`, the subcommand name stays at `argv[1]`.
+     * @param argv The argv passed to `preprocess()`, which is permuted.
+     * @param name Argument name, used for the help message (e.g., "extra-files").
+     * @param description Positional arguments description, used for the help message.
+     * @param required If true and there are no remaining arguments,
+                       the program will report an error and exit.
+     * @return The remaining arguments, at the end of argv.
+     */
+    [[nodiscard]]
+    Parser::ArgvSpan getRemainingPositionalsInPlace(
+        char **argv, const std::string &posName, std::string description, bool required = true) const {
+
+        if (!isActive()) { return {}; }
+        return Parser::getRemainingPositionalsInPlace_(argv, posName, std::move(description), required, Parser::data_);
     }
 
     /**
      * @brief Inserts a custom option header to the help message.
      * @details See the README for details.
-     * @param header The option header text.
+     * @param header The option header text. A `const char` array is not copied (see `HelpText`).
      */
-    void insertOptHeader(std::string header) const {
+    void insertOptHeader(HelpText header) const {
         if (!isActive()) { return; }
         Parser::insertOptHeader_(std::move(header));
     }
@@ -505,7 +1175,7 @@ public:
      */
     void pushBackErrorMsg(std::string msg) const {
         if (!isActive()) { return; }
-        Parser::data_.errorMessages.push_back(std::move(msg));
+        Parser::pushCustomError(std::move(msg));
     }
 
     /**
@@ -528,3 +1198,4 @@ private:
 
 #include "Get.hpp"            // IWYU pragma: keep
 #include "PrePostProcess.hpp" // IWYU pragma: keep
+#include "ParsedArgs.hpp"     // IWYU pragma: keep
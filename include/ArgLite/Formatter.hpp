@@ -1,5 +1,10 @@
 #pragma once
+#include "OutputSink.hpp"
+#include <algorithm>
+#ifndef ARGLITE_NO_IOSTREAM
 #include <iostream>
+#endif
+#include <cstdlib>
 #include <string>
 #include <string_view>
 #ifdef _WIN32
@@ -16,39 +21,137 @@ namespace ArgLite {
 
 class Formatter {
 public:
-    static auto red(std::string_view sv, [[maybe_unused]] const std::ostream &os = std::cerr) {
-#ifdef ARGLITE_ENABLE_FORMATTER
-        return format(sv, ANSI_RED, os);
-#else
-        return sv;
+    enum class Style { Red, Yellow, Bold, BoldUnderline };
+
+    /**
+     * @brief A view tagged with the ANSI sequence it is printed with.
+     * @details It is appended to an output buffer directly, so no temporary string is built for the fragment.
+     */
+    struct Styled {
+        std::string_view text;
+        std::string_view code; // Empty if formatting is disabled
+
+        template <typename Str>
+        void appendTo(Str &out) const {
+            if (code.empty()) {
+                out.append(text);
+            } else {
+                out.append(code).append(text).append(ANSI_RESET);
+            }
+        }
+
+        // Appends in place, so `str += Formatter::bold(...)` builds no temporary string
+        friend std::string &operator+=(std::string &out, const Styled &styled) {
+            styled.appendTo(out);
+            return out;
+        }
+
+        // For code that stores the result of `red()` and the like as a string
+        operator std::string() const { // NOLINT(google-explicit-constructor)
+            std::string result;
+            appendTo(result);
+            return result;
+        }
+
+        // Passes the pieces of the fragment to `write`, for writers that are neither strings nor streams
+        template <typename F>
+        void forEachPart(F &&write) const {
+            if (!code.empty()) { write(code); }
+            write(text);
+            if (!code.empty()) { write(ANSI_RESET); }
+        }
+
+#ifndef ARGLITE_NO_IOSTREAM
+        // The field width applies to the whole fragment, like it did to the formatted string
+        void writeTo(std::ostream &os) const {
+            auto size  = static_cast<std::streamsize>(code.empty() ? text.size() : code.size() + text.size() + ANSI_RESET.size());
+            auto pad   = std::max<std::streamsize>(os.width(0) - size, 0);
+            bool left  = (os.flags() & std::ios_base::adjustfield) == std::ios_base::left;
+            auto fill  = [&os, pad]() {
+                for (std::streamsize i = 0; i < pad; i++) { os.put(os.fill()); }
+            };
+            if (!left) { fill(); }
+            if (code.empty()) {
+                os << text;
+            } else {
+                os << code << text << ANSI_RESET;
+            }
+            if (left) { fill(); }
+        }
+
+        friend std::ostream &operator<<(std::ostream &os, const Styled &styled) {
+            styled.writeTo(os);
+            return os;
+        }
 #endif
+    };
+
+    /**
+     * @brief Tags a view with a style, the style is dropped if the sink does not support ANSI sequences.
+     */
+    static Styled styled(std::string_view sv, Style style, const OutputSink &sink) {
+        return {sv, isEnabled(sink) ? styleCode(style) : std::string_view()};
     }
 
-    static auto yellow(std::string_view sv, [[maybe_unused]] const std::ostream &os = std::cerr) {
-#ifdef ARGLITE_ENABLE_FORMATTER
-        return format(sv, ANSI_YELLOW, os);
-#else
-        return sv;
-#endif
+    /**
+     * @brief Appends a styled view to the output buffer, any string type with `append` works.
+     */
+    template <typename Str>
+    static void append(Str &out, std::string_view sv, Style style, const OutputSink &sink) {
+        styled(sv, style, sink).appendTo(out);
     }
 
-    static auto bold(std::string_view sv, [[maybe_unused]] const std::ostream &os = std::cout) {
+    /**
+     * @brief Checks if ANSI sequences should be written to the file descriptor.
+     * @details The result is detected once and cached for stdout and stderr.
+     * `NO_COLOR` (non-empty) and `TERM=dumb` disable formatting.
+     */
+    static bool isEnabled([[maybe_unused]] int fd) {
 #ifdef ARGLITE_ENABLE_FORMATTER
-        return format(sv, ANSI_BOLD, os);
+        static const bool envAllowed = isEnvAllowed();
+        static const bool stdoutTty  = static_cast<bool>(ISATTY(1));
+        static const bool stderrTty  = static_cast<bool>(ISATTY(2));
+
+        if (!envAllowed || fd < 0) { return false; }
+        if (fd == 1) { return stdoutTty; }
+        if (fd == 2) { return stderrTty; }
+        return static_cast<bool>(ISATTY(fd));
 #else
-        return sv;
+        return false;
 #endif
     }
 
-    static auto boldUnderline(std::string_view sv, [[maybe_unused]] const std::ostream &os = std::cout) {
-#ifdef ARGLITE_ENABLE_FORMATTER
-        return format(sv, ANSI_BOLD_UNDERLINE, os);
-#else
-        return sv;
-#endif
+    static bool isEnabled(const OutputSink &sink) { return isEnabled(sink.descriptor()); }
+
+#ifndef ARGLITE_NO_IOSTREAM
+    static Styled styled(std::string_view sv, Style style, const std::ostream &os) {
+        return {sv, shouldFormat(os) ? styleCode(style) : std::string_view()};
     }
+#endif
+
+    static Styled red(std::string_view sv, const OutputSink &sink) { return styled(sv, Style::Red, sink); }
+
+    static Styled yellow(std::string_view sv, const OutputSink &sink) { return styled(sv, Style::Yellow, sink); }
+
+    static Styled bold(std::string_view sv, const OutputSink &sink) { return styled(sv, Style::Bold, sink); }
+
+    static Styled boldUnderline(std::string_view sv, const OutputSink &sink) { return styled(sv, Style::BoldUnderline, sink); }
+
+#ifdef ARGLITE_NO_IOSTREAM
+    static Styled red(std::string_view sv) { return red(sv, OutputSink::fd(2)); }
+    static Styled yellow(std::string_view sv) { return yellow(sv, OutputSink::fd(2)); }
+    static Styled bold(std::string_view sv) { return bold(sv, OutputSink::fd(1)); }
+    static Styled boldUnderline(std::string_view sv) { return boldUnderline(sv, OutputSink::fd(1)); }
+#else
+    static Styled red(std::string_view sv, const std::ostream &os = std::cerr) { return styled(sv, Style::Red, os); }
+
+    static Styled yellow(std::string_view sv, const std::ostream &os = std::cerr) { return styled(sv, Style::Yellow, os); }
+
+    static Styled bold(std::string_view sv, const std::ostream &os = std::cout) { return styled(sv, Style::Bold, os); }
+
+    static Styled boldUnderline(std::string_view sv, const std::ostream &os = std::cout) { return styled(sv, Style::BoldUnderline, os); }
+#endif // ARGLITE_NO_IOSTREAM
 
-#ifdef ARGLITE_ENABLE_FORMATTER
 private:
     static constexpr std::string_view ANSI_RESET          = "\x1b[0m";
     static constexpr std::string_view ANSI_RED            = "\x1b[91m";
@@ -56,22 +159,39 @@ private:
     static constexpr std::string_view ANSI_BOLD           = "\x1b[1m";
     static constexpr std::string_view ANSI_BOLD_UNDERLINE = "\x1b[1m\x1b[4m";
 
-    static std::string format(std::string_view sv, std::string_view code, const std::ostream &os = std::cout) {
-        std::string result;
-        result.reserve(sv.size());
-        if (shouldFormat(os)) {
-            result.append(code).append(sv).append(ANSI_RESET);
-        } else {
-            result.append(sv);
+    static constexpr std::string_view styleCode(Style style) {
+        switch (style) {
+        case Style::Red: return ANSI_RED;
+        case Style::Yellow: return ANSI_YELLOW;
+        case Style::Bold: return ANSI_BOLD;
+        case Style::BoldUnderline: return ANSI_BOLD_UNDERLINE;
         }
+        return {};
+    }
 
-        return result;
+#ifdef ARGLITE_ENABLE_FORMATTER
+    static bool isEnvAllowed() {
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4996) // getenv is only read here
+#endif
+        const char *noColor = std::getenv("NO_COLOR");
+        const char *term    = std::getenv("TERM");
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+        if (noColor != nullptr && noColor[0] != '\0') { return false; }
+        return term == nullptr || std::string_view(term) != "dumb";
     }
+#endif
 
-    static bool shouldFormat(const std::ostream &os) {
+#ifndef ARGLITE_NO_IOSTREAM
+    static bool shouldFormat([[maybe_unused]] const std::ostream &os) {
+#ifdef ARGLITE_ENABLE_FORMATTER
         auto *buf = os.rdbuf();
-        if (buf == std::cout.rdbuf()) return static_cast<bool>(ISATTY(FILENO(stdout)));
-        if (buf == std::cerr.rdbuf()) return static_cast<bool>(ISATTY(FILENO(stderr)));
+        if (buf == std::cout.rdbuf()) { return isEnabled(1); }
+        if (buf == std::cerr.rdbuf()) { return isEnabled(2); }
+#endif
         return false; // default
     }
 #endif
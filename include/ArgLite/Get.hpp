@@ -4,31 +4,37 @@
 #include "Formatter.hpp"
 #include "GetTemplate.hpp" // IWYU pragma: keep
 #include <algorithm>
+#include <cctype>
 #include <cstddef>
-#include <iostream>
+#include <cstdlib>
+#include <optional>
 #include <string>
 #include <string_view>
-#include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#ifndef _WIN32
+extern char **environ; // NOLINT(readability-redundant-declaration): not every libc declares it
+#endif
+
 namespace ArgLite {
 
 inline bool Parser::hasFlag_(
-    std::string_view optName, std::string description, InternalData &data) {
+    std::string_view optName, HelpText description, InternalData &data) {
 
     return countFlag_(optName, std::move(description), data) > 0;
 }
 
 inline unsigned Parser::countFlag_(
-    std::string_view optName, std::string description, InternalData &data) {
+    std::string_view optName, HelpText description, InternalData &data) {
 
     auto [shortOpt, longOpt] = parseOptNameAsPair(optName);
-    data.optionHelpEntries.push_back({shortOpt, longOpt, std::move(description), ""});
+    pushOptionHelp(data, shortOpt, longOpt, std::move(description));
 
     auto getOptInfoArr = [&data](const std::string &optName) {
-        auto node       = data.options.extract(optName);
-        auto optInfoArr = node.empty() ? std::vector<OptionInfo>() : std::move(node.mapped());
+        auto node       = extractOption(optName, data);
+        auto optInfoArr = node.empty() ? OptionInfoArr() : std::move(node.mapped());
         restorePosArgsInFlags(optInfoArr, data.positionalArgsIndices);
         return optInfoArr;
     };
@@ -36,19 +42,21 @@ inline unsigned Parser::countFlag_(
     auto longOptInfoArr  = getOptInfoArr(longOpt);
     auto shortOptInfoArr = getOptInfoArr(shortOpt);
 
-    return static_cast<unsigned>(longOptInfoArr.size() + shortOptInfoArr.size());
+    auto count = static_cast<unsigned>(longOptInfoArr.size() + shortOptInfoArr.size());
+    if (isRecording()) { recordOption(data, shortOpt, longOpt, count); }
+    return count;
 }
 
 bool Parser::hasMutualExFlag_(HasMutualExArgs args, InternalData &data) {
     auto [trueShortOpt, trueLongOpt]   = parseOptNameAsPair(args.trueOptName);
     auto [falseShortOpt, falseLongOpt] = parseOptNameAsPair(args.falseOptName);
 
-    data.optionHelpEntries.push_back({trueShortOpt, trueLongOpt, std::move(args.trueDescription), "", "", false, args.defaultValue});
-    data.optionHelpEntries.push_back({falseShortOpt, falseLongOpt, std::move(args.falseDescription), "", "", false, !args.defaultValue});
+    pushOptionHelp(data, trueShortOpt, trueLongOpt, std::move(args.trueDescription), HelpText(), HelpText(), false, args.defaultValue);
+    pushOptionHelp(data, falseShortOpt, falseLongOpt, std::move(args.falseDescription), HelpText(), HelpText(), false, !args.defaultValue);
 
     auto getOptIndex = [&data](const std::string &optName) {
-        auto node       = data.options.extract(optName);
-        auto optInfoArr = node.empty() ? std::vector<OptionInfo>() : std::move(node.mapped());
+        auto node       = extractOption(optName, data);
+        auto optInfoArr = node.empty() ? OptionInfoArr() : std::move(node.mapped());
         restorePosArgsInFlags(optInfoArr, data.positionalArgsIndices);
         return optInfoArr.empty() ? 0 : optInfoArr.back().argvIndex;
     };
@@ -62,13 +70,22 @@ bool Parser::hasMutualExFlag_(HasMutualExArgs args, InternalData &data) {
     auto falseIndex = std::min(falseShortIndex, falseLongIndex);
 
     // They are negative, so Smaller is latter
-    return trueIndex < falseIndex;
+    bool result = trueIndex < falseIndex;
+
+    // Both options are recorded with their own value, a count of 1 means it was passed
+    if (isRecording()) {
+        recordOption(data, trueShortOpt, trueLongOpt, trueIndex != 0 ? 1 : 0);
+        recordValueOf(data, result);
+        recordOption(data, falseShortOpt, falseLongOpt, falseIndex != 0 ? 1 : 0);
+        recordValueOf(data, !result);
+    }
+    return result;
 }
 
-void Parser::restorePosArgsInFlags(const std::vector<OptionInfo> &optInfoArr, std::vector<int> &positionalArgsIndices) {
+void Parser::restorePosArgsInFlags(const OptionInfoArr &optInfoArr, Vector<int> &positionalArgsIndices) {
     for (const auto &it : optInfoArr) {
         // A flag was passed with a value, e.g., -f 123. The value is likely a positional arg.
-        if (it.argvIndex > 0) {
+        if (it.argvIndex > 0 && it.valueOffset == 0) {
             positionalArgsIndices.push_back(it.argvIndex);
         }
     }
@@ -93,7 +110,12 @@ std::string Parser::parseOptName(std::string_view optName) {
 // Parses option name (o,out) and saves the results in shortOpt (-o) and longOpt (--out)
 std::pair<std::string, std::string> Parser::parseOptNameAsPair(std::string_view optName) {
     if (optName.empty()) {
-        std::cerr << "[ArgLite] Error: Option name in hasFlag/get* functions cannot be empty." << '\n';
+        // The option is never found, so the get functions return their defaults
+        if (embedded_) {
+            pushCustomError("[ArgLite] Option name in hasFlag/get* functions cannot be empty.");
+            return {};
+        }
+        errSink_.write("[ArgLite] Error: Option name in hasFlag/get* functions cannot be empty.\n");
         std::exit(EXIT_FAILURE);
     }
 
@@ -116,154 +138,304 @@ std::pair<std::string, std::string> Parser::parseOptNameAsPair(std::string_view
     return {shortOpt, longOpt};
 }
 
+// Removes the option from the map. Only the pmr key type differs from std::string, and needs a copy
+inline Parser::OptMap::node_type Parser::extractOption(const std::string &optName, InternalData &data) {
+#ifdef ARGLITE_ENABLE_PMR
+    auto node = data.options.extract(newString(optName, data));
+#else
+    auto node = data.options.extract(optName);
+#endif
+    // A declared option named -h or --help takes precedence over the help request
+    if (data.helpRequested && !node.empty() && (optName == "-h" || optName == "--help")) {
+        data.helpRequested = (data.options.count("-h") != 0) || (data.options.count("--help") != 0);
+    }
+    return node;
+}
+
+inline Parser::String Parser::newString(std::string_view sv, [[maybe_unused]] const InternalData &data) {
+#ifdef ARGLITE_ENABLE_PMR
+    return String(sv, data.helpArena.get_allocator());
+#else
+    return String(sv);
+#endif
+}
+
+// === Helper functions for help entries ===
+
+// Keeps literals as views and appends other strings to the help arena
+inline Parser::HelpStr Parser::storeHelpStr(HelpText text, InternalData &data) {
+    if (!text.isOwned_) {
+        return {text.view_.data(), 0, static_cast<std::uint32_t>(text.view_.size())};
+    }
+    return copyHelpStr(text.owned_, data);
+}
+
+inline Parser::HelpStr Parser::copyHelpStr(std::string_view sv, InternalData &data) {
+    if (sv.empty()) { return {}; }
+    HelpStr str{nullptr, static_cast<std::uint32_t>(data.helpArena.size()), static_cast<std::uint32_t>(sv.size())};
+    data.helpArena.append(sv);
+    return str;
+}
+
+inline std::string_view Parser::viewHelpStr(const HelpStr &str, const InternalData &data) {
+    if (str.literal != nullptr) { return {str.literal, str.size}; }
+    if (str.size == 0) { return {}; }
+    return std::string_view(data.helpArena).substr(str.offset, str.size);
+}
+
+inline void Parser::pushOptionHelp(
+    InternalData &data, std::string_view shortOpt, std::string_view longOpt,
+    HelpText description, HelpText defaultValue, HelpText typeName,
+    bool isRequired, bool isMutualExDefault, HelpText envName) {
+
+    data.optionHelpEntries.push_back({copyHelpStr(shortOpt, data),
+                                      copyHelpStr(longOpt, data),
+                                      storeHelpStr(std::move(description), data),
+                                      storeHelpStr(std::move(defaultValue), data),
+                                      storeHelpStr(std::move(typeName), data),
+                                      storeHelpStr(std::move(envName), data),
+                                      isRequired, isMutualExDefault, false});
+}
+
+// === Environment Variables ===
+
+// Scans the environment once, only the variables with the prefix are indexed
+inline void Parser::indexEnv() {
+#ifdef _WIN32
+    char **envp = _environ;
+#else
+    char **envp = environ;
+#endif
+    envIndex_.clear();
+    for (; envp != nullptr && *envp != nullptr; envp++) {
+        std::string_view entry(*envp);
+        if (entry.compare(0, envPrefix_.size(), envPrefix_) != 0) { continue; }
+
+        auto equalPos = entry.find('=');
+        if (equalPos == std::string_view::npos || equalPos == 0) { continue; }
+        // The first one wins if a name is repeated, like getenv
+        envIndex_.emplace(entry.substr(0, equalPos), entry.substr(equalPos + 1));
+    }
+    envIndexed_ = true;
+}
+
+inline std::optional<std::string_view> Parser::lookupEnv(std::string_view name) {
+    if (name.empty()) { return std::nullopt; }
+
+    // Names set by `env()` may be outside the prefix, they are looked up one by one
+    if (name.compare(0, envPrefix_.size(), envPrefix_) != 0) {
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4996) // getenv is only read here
+#endif
+        const char *value = std::getenv(std::string(name).c_str());
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+        if (value == nullptr) { return std::nullopt; }
+        return std::string_view(value);
+    }
+
+    if (!envIndexed_) { indexEnv(); }
+    auto it = envIndex_.find(name);
+    if (it == envIndex_.end()) { return std::nullopt; }
+    return it->second;
+}
+
 class Parser::OptValHelper {
     template <typename T> friend class OptValBuilder;
 
+    // The option handle is the index of its help entry, which is pushed before the value is parsed
+    static std::uint32_t lastOptionHandle(const InternalData &data) {
+        return static_cast<std::uint32_t>(data.optionHelpEntries.size() - 1);
+    }
+
     static void appendOptValErrorMsg(
-        InternalData    &data,
-        std::string_view optName, const std::string &typeName, const std::string &valueStr) {
+        InternalData &data, int argvIndex, std::string_view typeName, std::string_view valueStr) {
 
-        std::string errorStr;
-        errorStr += "Invalid value for option '";
-        errorStr += Formatter::bold(parseOptName(optName), std::cerr);
-        errorStr += "'. Expected a ";
-        errorStr += Formatter::bold(typeName, std::cerr);
-        errorStr += ", but got '";
-        errorStr += Formatter::yellow(valueStr);
-        errorStr += "'.";
-        data.errorMessages.push_back(std::move(errorStr));
+        pushError(data, {ErrorCode::InvalidValue, lastOptionHandle(data), argvIndex, valueStr, typeName});
     }
 
-    static void appendNoOptErrorMsg(
-        InternalData &data, std::string_view optName) {
+    // A value used when the option is not passed, from the environment or the config file
+    struct FallbackValue {
+        ErrorCode        code; // Reported if the value cannot be converted
+        std::string_view value;
+    };
+
+    static void appendFallbackErrorMsg(
+        InternalData &data, ErrorCode code, std::string_view typeName, std::string_view valueStr) {
 
-        std::string errorStr;
-        errorStr += "Option '";
-        errorStr += Formatter::bold(parseOptName(optName));
-        errorStr += "' is required, you cannot run this command without it.";
-        data.errorMessages.push_back(std::move(errorStr));
+        pushError(data, {code, lastOptionHandle(data), -1, valueStr, typeName});
     }
 
-    static bool hasNoValOpt(const std::vector<OptionInfo> &optInfoArr,
-                            std::string_view optName, std::vector<std::string> &errorMessages) {
+    // The fallback value of the last option, the environment variable wins over the config file
+    static std::optional<FallbackValue> getFallbackValue(const InternalData &data) {
+        const auto &entry = data.optionHelpEntries.back();
+        if (auto envValue = lookupEnv(viewHelpStr(entry.envName, data))) {
+            return FallbackValue{ErrorCode::InvalidEnvValue, *envValue};
+        }
+#ifdef ARGLITE_ENABLE_CONFIG_FILE
+        auto longOpt = viewHelpStr(entry.longOpt, data);
+        if (config_.isOpen() && longOpt.size() > 2) {
+            // Each subcommand has its own section
+            std::string_view section;
+            if (activeSubCmd_ != nullptr) { section = activeSubCmd_->subCommandName_; }
+            if (auto configValue = config_.find(section, longOpt.substr(2))) {
+                return FallbackValue{ErrorCode::InvalidConfigValue, *configValue};
+            }
+        }
+#endif
+        return std::nullopt;
+    }
+
+    static void appendNoOptErrorMsg(InternalData &data) {
+        pushError(data, {ErrorCode::MissingOption, lastOptionHandle(data), -1, {}, {}});
+    }
+
+    static bool hasNoValOpt(const OptionInfoArr &optInfoArr, InternalData &data) {
         bool hasNoValOpt = false;
 
         for (const auto &it : optInfoArr) {
             if (it.argvIndex < 0) { // It's treated as a flag, indicating that it has no value
                 hasNoValOpt = true;
-                std::string msg("Option '");
-                msg.append(Formatter::bold(parseOptName(optName)));
-                msg.append("' requires a value.");
-                errorMessages.push_back(std::move(msg));
+                pushError(data, {ErrorCode::MissingValue, lastOptionHandle(data), -it.argvIndex, {}, {}});
             }
         }
 
         return hasNoValOpt;
     }
 
-    // Uses the option name to get a value string from the options_ map.
-    // Returns {found, hasNoValOpt, longOptInfoArr, shortOptInfoArr}
-    static std::tuple<bool, bool, std::vector<OptionInfo>, std::vector<OptionInfo>> getLongShortOptArr(
-        std::string_view optName, const std::string &shortOpt, const std::string &longOpt,
-        InternalData &data) {
+    // The occurrences of an option, moved out of the options map
+    struct OptOccurrences {
+        bool                    found       = false;
+        bool                    hasNoValOpt = false;
+        OptionInfoArr longOptInfoArr;
+        OptionInfoArr shortOptInfoArr;
+    };
+
+    // Uses the option name to extract the occurrences from the options map.
+    static OptOccurrences getLongShortOptArr(
+        const std::string &shortOpt, const std::string &longOpt, InternalData &data) {
 
-        auto longNode  = data.options.extract(longOpt);
-        auto shortNode = data.options.extract(shortOpt);
+        auto longNode  = extractOption(longOpt, data);
+        auto shortNode = extractOption(shortOpt, data);
 
+        OptOccurrences occurrences;
         // Both long and short options are not found
-        if (longNode.empty() && shortNode.empty()) {
-            return {false, false, {}, {}};
-        }
+        if (longNode.empty() && shortNode.empty()) { return occurrences; }
 
         // At least one option is found, so at least one array is not empty
-        auto emptyArr        = std::vector<OptionInfo>();
-        auto longOptInfoArr  = longNode.empty() ? emptyArr : std::move(longNode.mapped());
-        auto shortOptInfoArr = shortNode.empty() ? emptyArr : std::move(shortNode.mapped());
+        if (!longNode.empty()) { occurrences.longOptInfoArr = std::move(longNode.mapped()); }
+        if (!shortNode.empty()) { occurrences.shortOptInfoArr = std::move(shortNode.mapped()); }
 
-        if (hasNoValOpt(longOptInfoArr, optName, data.errorMessages) ||
-            hasNoValOpt(shortOptInfoArr, optName, data.errorMessages)) {
-            return {false, true, {}, {}};
+        if (hasNoValOpt(occurrences.longOptInfoArr, data) ||
+            hasNoValOpt(occurrences.shortOptInfoArr, data)) {
+            occurrences.hasNoValOpt = true;
+            return occurrences;
         }
 
-        return {true, false, longOptInfoArr, shortOptInfoArr};
+        occurrences.found = true;
+        return occurrences;
+    }
+
+    // The value of an occurrence, it views argv
+    static std::string_view viewValueStr(const OptionInfo &optInfo) {
+        return {argv_[optInfo.argvIndex] + optInfo.valueOffset, optInfo.valueLength};
     }
 
-    static std::string getValueStr(
-        std::vector<OptionInfo> longOptInfoArr, std::vector<OptionInfo> shortOptInfoArr) {
+    // Gets the last occurrence, its value is the value of the option
+    static const OptionInfo &getLastOccurrence(const OptOccurrences &occurrences) {
+        const auto &longArr  = occurrences.longOptInfoArr;
+        const auto &shortArr = occurrences.shortOptInfoArr;
 
-        auto longIndex  = longOptInfoArr.empty() ? 0 : longOptInfoArr.back().argvIndex;
-        auto shortIndex = shortOptInfoArr.empty() ? 0 : shortOptInfoArr.back().argvIndex;
+        auto longIndex  = longArr.empty() ? 0 : longArr.back().argvIndex;
+        auto shortIndex = shortArr.empty() ? 0 : shortArr.back().argvIndex;
 
-        auto &optInfo = longIndex > shortIndex ? longOptInfoArr.back() : shortOptInfoArr.back();
-        if (!optInfo.valueStr.empty()) { return std::move(optInfo.valueStr); }
-        return argv_[optInfo.argvIndex];
+        return longIndex > shortIndex ? longArr.back() : shortArr.back();
     }
 
-    static std::vector<std::string> getValueStrVec(
-        std::vector<OptionInfo> longOptInfoArr, std::vector<OptionInfo> shortOptInfoArr) {
+    // Calls `func` with each part of the value split by the delimiter, or the whole value if it is '\0'
+    template <typename F>
+    static void forEachPart(std::string_view valueStr, char delimiter, F &&func) {
+        if (delimiter == '\0') {
+            func(valueStr);
+            return;
+        }
+        size_t delimiterPos = 0;
+        while ((delimiterPos = valueStr.find(delimiter)) != std::string_view::npos) {
+            func(valueStr.substr(0, delimiterPos));
+            valueStr.remove_prefix(delimiterPos + 1);
+        }
+        // Add the last part
+        func(valueStr);
+    }
 
-        std::vector<std::string> valueStrVec;
-        valueStrVec.reserve(longOptInfoArr.size() + shortOptInfoArr.size());
+    // Calls `func` with each value and the argv index it comes from in the argv order,
+    // values are split by the delimiter if it is not '\0'
+    template <typename F>
+    static void forEachValueStr(const OptOccurrences &occurrences, char delimiter, F &&func) {
+        const auto &longArr  = occurrences.longOptInfoArr;
+        const auto &shortArr = occurrences.shortOptInfoArr;
+
+        auto visit = [delimiter, &func](const OptionInfo &optInfo) {
+            forEachPart(viewValueStr(optInfo), delimiter, [&func, &optInfo](std::string_view part) {
+                func(part, optInfo.argvIndex);
+            });
+        };
 
+        // Merge the two sorted arrays
         size_t longIdx  = 0;
         size_t shortIdx = 0;
-
-        auto appendValStrFromOptInfo = [&valueStrVec](OptionInfo *optInfo) {
-            if (!optInfo->valueStr.empty()) {
-                valueStrVec.push_back(std::move(optInfo->valueStr));
-            } else {
-                valueStrVec.emplace_back(argv_[optInfo->argvIndex]);
-            }
-        };
-
-        while (longIdx < longOptInfoArr.size() && shortIdx < shortOptInfoArr.size()) {
-            OptionInfo *currentOptInfo = nullptr;
-            if (longOptInfoArr[longIdx].argvIndex < shortOptInfoArr[shortIdx].argvIndex) {
-                currentOptInfo = &longOptInfoArr[longIdx++];
+        while (longIdx < longArr.size() && shortIdx < shortArr.size()) {
+            if (longArr[longIdx].argvIndex < shortArr[shortIdx].argvIndex) {
+                visit(longArr[longIdx++]);
             } else {
-                currentOptInfo = &shortOptInfoArr[shortIdx++];
+                visit(shortArr[shortIdx++]);
             }
-
-            appendValStrFromOptInfo(currentOptInfo);
-        }
-
-        while (longIdx < longOptInfoArr.size()) {
-            appendValStrFromOptInfo(&longOptInfoArr[longIdx]);
-            longIdx++;
         }
-
-        while (shortIdx < shortOptInfoArr.size()) {
-            appendValStrFromOptInfo(&shortOptInfoArr[shortIdx]);
-            shortIdx++;
-        }
-
-        return valueStrVec;
+        for (; longIdx < longArr.size(); longIdx++) { visit(longArr[longIdx]); }
+        for (; shortIdx < shortArr.size(); shortIdx++) { visit(shortArr[shortIdx]); }
     }
 
-    static std::vector<std::string> getSplittedStrVec(
-        std::vector<std::string> &valueStrVec, char delimiter) {
-
-        std::vector<std::string> splittedStrVec;
-        splittedStrVec.reserve(valueStrVec.size());
-
-        for (auto &valueStr : valueStrVec) {
-            auto delimiterPos = valueStr.find(delimiter);
-            if (delimiterPos == std::string::npos) {
-                splittedStrVec.push_back(std::move(valueStr));
+    // Calls `func` with each `key=value` value split on the first `=` and converted to K and V,
+    // invalid values are reported and skipped
+    template <typename K, typename V, typename F>
+    static void forEachKeyValue(const OptOccurrences &occurrences, InternalData &data, F &&func) {
+        forEachValueStr(occurrences, '\0', [&data, &func](std::string_view valueStr, int argvIndex) {
+            auto equalsPos = valueStr.find('=');
+            if (equalsPos == std::string_view::npos) {
+                appendOptValErrorMsg(data, argvIndex, "key=value", valueStr);
+                return;
             }
-            // The delemiter is found, split the string
-            else {
-                size_t currentPos = 0;
-                while ((delimiterPos = valueStr.find(delimiter, currentPos)) != std::string::npos) {
-                    splittedStrVec.push_back(valueStr.substr(currentPos, delimiterPos - currentPos));
-                    currentPos = delimiterPos + 1;
-                }
-                // Add the last part
-                splittedStrVec.push_back(valueStr.substr(currentPos));
+            auto keyStr = valueStr.substr(0, equalsPos);
+            auto valStr = valueStr.substr(equalsPos + 1);
+
+            K key{};
+            V value{};
+            if (!convertType(keyStr, key)) {
+                appendOptValErrorMsg(data, argvIndex, getTypeName<K>(), keyStr);
+                return;
             }
-        }
+            if (!convertType(valStr, value)) {
+                appendOptValErrorMsg(data, argvIndex, getTypeName<V>(), valStr);
+                return;
+            }
+            func(std::move(key), std::move(value), keyStr, argvIndex);
+        });
+    }
 
-        return splittedStrVec;
+    static void appendDuplicateKeyErrorMsg(InternalData &data, int argvIndex, std::string_view keyStr) {
+        pushError(data, {ErrorCode::DuplicateKey, lastOptionHandle(data), argvIndex, keyStr, {}});
+    }
+
+    // Counts the values, so the result can be allocated at once
+    static size_t countValueStr(const OptOccurrences &occurrences, char delimiter) {
+        size_t count = occurrences.longOptInfoArr.size() + occurrences.shortOptInfoArr.size();
+        if (delimiter == '\0') { return count; }
+
+        count = 0;
+        forEachValueStr(occurrences, delimiter, [&count](std::string_view, int) { count++; });
+        return count;
     }
 };
 
@@ -272,14 +444,13 @@ class Parser::OptValBuilder {
 public:
     using Helper = OptValHelper;
 
-    OptValBuilder(std::string_view optName, std::string description,
+    OptValBuilder(std::string_view optName, HelpText description,
                   InternalData &data, const SubParser *passedSubCmd)
         : optName_(optName),
           description_(std::move(description)),
+          typeName_(HelpText::fromStatic(getTypeName<T>())),
           data_(data),
-          passedSubCmd_(passedSubCmd) {
-        typeName_ = getTypeName<T>();
-    }
+          passedSubCmd_(passedSubCmd) {}
 
     /**
      * @brief Sets the default value for the option.
@@ -289,6 +460,25 @@ public:
     [[nodiscard]]
     OptValBuilder<T> &setDefault(T defaultValue) {
         defaultValue_ = defaultValue;
+        defaultFn_    = nullptr;
+        return *this;
+    }
+
+    /**
+     * @brief Sets a function that computes the default value for the option.
+     * @details The function is only called when the default value is needed,
+                i.e., the option is not provided or its value is invalid.
+                It is not called for inactive subcommands.
+     * @param defaultFn The function that returns the default value.
+     * @param defaultStr The default value shown in the help message. If it is empty,
+                         the function is called to render the help message.
+     * @return A reference to the current `OptValBuilder` instance for chaining.
+     */
+    template <typename F>
+    [[nodiscard]]
+    OptValBuilder<T> &setDefaultFn(F defaultFn, HelpText defaultStr = HelpText()) {
+        defaultFn_  = std::move(defaultFn);
+        defaultStr_ = std::move(defaultStr);
         return *this;
     }
 
@@ -298,7 +488,7 @@ public:
      * @return A reference to the current `OptValBuilder` instance for chaining.
      */
     [[nodiscard]]
-    OptValBuilder<T> &setTypeName(std::string typeName) {
+    OptValBuilder<T> &setTypeName(HelpText typeName) {
         typeName_ = std::move(typeName);
         return *this;
     }
@@ -313,6 +503,19 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Sets the environment variable used when the option is not passed on the command line.
+     * @details The precedence is command line > environment variable > default value,
+                and a required option is satisfied by the variable. It overrides the name from `setEnvPrefix()`.
+     * @param envName The name of the environment variable, e.g., `APP_THREADS`.
+     * @return A reference to the current `OptValBuilder` instance for chaining.
+     */
+    [[nodiscard]]
+    OptValBuilder<T> &env(HelpText envName) {
+        envName_ = std::move(envName);
+        return *this;
+    }
+
     /**
      * @brief Retrieves the option's value.
      * @return The parsed value of the option,
@@ -323,30 +526,17 @@ public:
         if (passedSubCmd_ != activeSubCmd_) { return defaultValue_; }
 
         auto [shortOpt, longOpt] = parseOptNameAsPair(optName_);
-        data_.optionHelpEntries.push_back(
-            {shortOpt, longOpt, std::move(description_),
-             toString(defaultValue_), typeName_, isRequied_});
-
-        auto [found, hasNoValOpt, longOptInfoArr, shortOptInfoArr] =
-            Helper::getLongShortOptArr(optName_, shortOpt, longOpt, data_);
+        pushOptionHelp(data_, shortOpt, longOpt, std::move(description_),
+                       defaultHelpStr(), std::move(typeName_), isRequied_, false, envHelpStr(longOpt));
 
-        if (hasNoValOpt) { return defaultValue_; }
+        auto occurrences = Helper::getLongShortOptArr(shortOpt, longOpt, data_);
+        auto result      = getValue(occurrences);
 
-        if (!found) {
-            if (isRequied_) {
-                Helper::appendNoOptErrorMsg(data_, optName_);
-            }
-            return defaultValue_;
-        }
-
-        auto valueStr = Helper::getValueStr(longOptInfoArr, shortOptInfoArr);
-
-        try {
-            return convertType<T>(valueStr);
-        } catch (...) {
-            Helper::appendOptValErrorMsg(data_, optName_, getTypeName<T>(), valueStr);
+        if (isRecording()) {
+            recordOption(data_, shortOpt, longOpt, static_cast<unsigned>(Helper::countValueStr(occurrences, '\0')));
+            recordValueOf(data_, result);
         }
-        return defaultValue_;
+        return result;
     }
 
     /**
@@ -370,122 +560,470 @@ public:
         if (passedSubCmd_ != activeSubCmd_) { return {}; }
 
         auto [shortOpt, longOpt] = parseOptNameAsPair(optName_);
-        data_.optionHelpEntries.push_back(
-            {shortOpt, longOpt, std::move(description_),
-             toString(defaultValue_), typeName_, isRequied_});
+        pushOptionHelp(data_, shortOpt, longOpt, std::move(description_),
+                       defaultHelpStr(), std::move(typeName_), isRequied_, false, envHelpStr(longOpt));
 
-        auto [found, hasNoValOpt, longOptInfoArr, shortOptInfoArr] =
-            Helper::getLongShortOptArr(optName_, shortOpt, longOpt, data_);
+        auto occurrences = Helper::getLongShortOptArr(shortOpt, longOpt, data_);
+        auto resultVec   = getValues(occurrences, delimiter);
 
-        if (hasNoValOpt) { return {}; }
+        if (isRecording()) {
+            recordOption(data_, shortOpt, longOpt, static_cast<unsigned>(Helper::countValueStr(occurrences, '\0')));
+            for (const auto &result : resultVec) { recordValueOf(data_, result); }
+        }
+        return resultVec;
+    }
+
+    /**
+     * @brief Retrieves the option's values with the argv index of each value, to group them by anchors.
+     * @details The same as `getVec()`, and `ScopedValues::groupOffsets()` assigns the values to the anchors
+                they precede, e.g., the codec of each input in `-c copy -i a.mp4 -c h264 -i b.mp4`.
+                Fallback values have the index 0, so they fall in the first group.
+     * @param delimiter The delimiter character used to split the option's value string, `\0` to not split it.
+     * @return The values and their argv indices.
+     */
+    [[nodiscard]]
+    ScopedValues<T> getScoped(char delimiter = '\0') {
+        if (passedSubCmd_ != activeSubCmd_) { return {}; }
+
+        auto [shortOpt, longOpt] = parseOptNameAsPair(optName_);
+        pushOptionHelp(data_, shortOpt, longOpt, std::move(description_),
+                       defaultHelpStr(), std::move(typeName_), isRequied_, false, envHelpStr(longOpt));
+
+        auto            occurrences = Helper::getLongShortOptArr(shortOpt, longOpt, data_);
+        ScopedValues<T> scoped;
+        if (occurrences.found) {
+            auto count = Helper::countValueStr(occurrences, delimiter);
+            scoped.values.reserve(count);
+            scoped.argvIndices.reserve(count);
+            Helper::forEachValueStr(occurrences, delimiter, [this, &scoped](std::string_view valueStr, int argvIndex) {
+                T result{};
+                if (convertType(valueStr, result)) {
+                    scoped.values.push_back(std::move(result));
+                    scoped.argvIndices.push_back(argvIndex);
+                } else {
+                    Helper::appendOptValErrorMsg(data_, argvIndex, getTypeName<T>(), valueStr);
+                }
+            });
+        } else {
+            scoped.values = getValues(occurrences, delimiter);
+            scoped.argvIndices.assign(scoped.values.size(), 0);
+        }
 
-        if (!found) {
+        if (isRecording()) {
+            recordOption(data_, shortOpt, longOpt, static_cast<unsigned>(Helper::countValueStr(occurrences, '\0')));
+            for (const auto &result : scoped.values) { recordValueOf(data_, result); }
+        }
+        return scoped;
+    }
+
+    /**
+     * @brief Retrieves `key=value` values, e.g., `-Dname=value` or `--set a.b=c`, as a flat map sorted by key.
+     * @details Each value is split on the first `=`, and the key and the value are converted from views of argv.
+                Use `std::string_view` for K or V to keep views of argv instead of copies. Values without `=`
+                and invalid keys or values are reported as errors and skipped.
+     * @tparam K The key type.
+     * @tparam V The value type, T by default.
+     * @param policy What to do when a key is passed more than once.
+     * @return The key-value pairs sorted by key, each key appears once.
+     */
+    template <typename K = std::string, typename V = T>
+    [[nodiscard]]
+    std::vector<std::pair<K, V>> getMap(DuplicateKeyPolicy policy = DuplicateKeyPolicy::LastWins) {
+        auto occurrences = getMapOccurrences();
+        if (!occurrences.found) { return {}; }
+
+        // Converted in the argv order, then sorted by key with the argv order kept for equal keys
+        auto                         count = Helper::countValueStr(occurrences, '\0');
+        std::vector<std::pair<K, V>> entries;
+        std::vector<std::pair<std::string_view, int>> sources; // The key string and argv index of each entry
+        entries.reserve(count);
+        sources.reserve(count);
+        Helper::template forEachKeyValue<K, V>(occurrences, data_, [&](K &&key, V &&value, std::string_view keyStr, int argvIndex) {
+            entries.emplace_back(std::move(key), std::move(value));
+            sources.emplace_back(keyStr, argvIndex);
+        });
+
+        std::vector<std::uint32_t> order(entries.size());
+        for (std::uint32_t i = 0; i < order.size(); i++) { order[i] = i; }
+        std::stable_sort(order.begin(), order.end(), [&entries](std::uint32_t lhs, std::uint32_t rhs) {
+            return entries[lhs].first < entries[rhs].first;
+        });
+
+        std::vector<std::pair<K, V>> result;
+        result.reserve(entries.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            bool isLastOfKey = i + 1 == order.size() || entries[order[i]].first < entries[order[i + 1]].first;
+            if (isLastOfKey) {
+                result.push_back(std::move(entries[order[i]]));
+            } else if (policy == DuplicateKeyPolicy::Error) {
+                // Reported at the later occurrence
+                const auto &source = sources[order[i + 1]];
+                Helper::appendDuplicateKeyErrorMsg(data_, source.second, source.first);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Retrieves `key=value` values as a hash map.
+     * @details The same as `getMap()`, the map is reserved for all values at once.
+     * @tparam K The key type, which must be hashable.
+     * @tparam V The value type, T by default.
+     * @param policy What to do when a key is passed more than once.
+     * @return The key-value map.
+     */
+    template <typename K = std::string, typename V = T>
+    [[nodiscard]]
+    std::unordered_map<K, V> getUnorderedMap(DuplicateKeyPolicy policy = DuplicateKeyPolicy::LastWins) {
+        auto occurrences = getMapOccurrences();
+        if (!occurrences.found) { return {}; }
+
+        std::unordered_map<K, V> result;
+        result.reserve(Helper::countValueStr(occurrences, '\0'));
+        Helper::template forEachKeyValue<K, V>(occurrences, data_, [&](K &&key, V &&value, std::string_view keyStr, int argvIndex) {
+            auto [it, inserted] = result.try_emplace(std::move(key), std::move(value));
+            if (inserted) { return; }
+            it->second = std::move(value); // NOLINT(bugprone-use-after-move): not moved if it is not inserted
+            if (policy == DuplicateKeyPolicy::Error) { Helper::appendDuplicateKeyErrorMsg(data_, argvIndex, keyStr); }
+        });
+        return result;
+    }
+
+private:
+    // The occurrences of a map option, map options have no fallback values
+    Helper::OptOccurrences getMapOccurrences() {
+        if (passedSubCmd_ != activeSubCmd_) { return {}; }
+
+        auto [shortOpt, longOpt] = parseOptNameAsPair(optName_);
+        pushOptionHelp(data_, shortOpt, longOpt, std::move(description_),
+                       HelpText(), std::move(typeName_), isRequied_);
+
+        auto occurrences = Helper::getLongShortOptArr(shortOpt, longOpt, data_);
+        if (!occurrences.found && !occurrences.hasNoValOpt && isRequied_) { Helper::appendNoOptErrorMsg(data_); }
+
+        if (isRecording()) {
+            recordOption(data_, shortOpt, longOpt, static_cast<unsigned>(Helper::countValueStr(occurrences, '\0')));
+            if (occurrences.found) {
+                Helper::forEachValueStr(occurrences, '\0', [this](std::string_view valueStr, int) { recordValue(data_, valueStr); });
+            }
+        }
+        return occurrences;
+    }
+
+    T getValue(const Helper::OptOccurrences &occurrences) {
+        if (occurrences.hasNoValOpt) { return getDefault(); }
+
+        if (!occurrences.found) {
+            if (auto fallback = Helper::getFallbackValue(data_)) {
+                T result{};
+                if (convertType(fallback->value, result)) { return result; }
+                Helper::appendFallbackErrorMsg(data_, fallback->code, getTypeName<T>(), fallback->value);
+                return getDefault();
+            }
             if (isRequied_) {
-                Helper::appendNoOptErrorMsg(data_, optName_);
+                Helper::appendNoOptErrorMsg(data_);
+            }
+            return getDefault();
+        }
+
+        const auto &last     = Helper::getLastOccurrence(occurrences);
+        auto        valueStr = Helper::viewValueStr(last);
+
+        T result{};
+        if (convertType(valueStr, result)) { return result; }
+        Helper::appendOptValErrorMsg(data_, last.argvIndex, getTypeName<T>(), valueStr);
+        return getDefault();
+    }
+
+    std::vector<T> getValues(const Helper::OptOccurrences &occurrences, char delimiter) {
+        if (occurrences.hasNoValOpt) { return {}; }
+
+        if (!occurrences.found) {
+            if (auto fallback = Helper::getFallbackValue(data_)) { return getFallbackValues(*fallback, delimiter); }
+            if (isRequied_) {
+                Helper::appendNoOptErrorMsg(data_);
             }
             return {};
         }
 
-        auto valueStrVec    = Helper::getValueStrVec(longOptInfoArr, shortOptInfoArr);
-        auto splittedStrVec = Helper::getSplittedStrVec(valueStrVec, delimiter);
+        // Convert each value to T straight from the views, so only the result is allocated
+        std::vector<T> resultVec;
+        resultVec.reserve(Helper::countValueStr(occurrences, delimiter));
+        Helper::forEachValueStr(occurrences, delimiter, [this, &resultVec](std::string_view valueStr, int argvIndex) {
+            T result{};
+            if (convertType(valueStr, result)) {
+                resultVec.push_back(std::move(result));
+            } else {
+                Helper::appendOptValErrorMsg(data_, argvIndex, getTypeName<T>(), valueStr);
+            }
+        });
 
-        // Convert each string to T
+        return resultVec;
+    }
+
+    std::vector<T> getFallbackValues(const Helper::FallbackValue &fallback, char delimiter) {
         std::vector<T> resultVec;
-        resultVec.reserve(splittedStrVec.size());
-        for (const auto &valueStr : splittedStrVec) {
-            try {
-                resultVec.push_back(convertType<T>(valueStr));
-            } catch (...) {
-                Helper::appendOptValErrorMsg(data_, optName_, getTypeName<T>(), valueStr);
+        Helper::forEachPart(fallback.value, delimiter, [this, &fallback, &resultVec](std::string_view valueStr) {
+            T result{};
+            if (convertType(valueStr, result)) {
+                resultVec.push_back(std::move(result));
+            } else {
+                Helper::appendFallbackErrorMsg(data_, fallback.code, getTypeName<T>(), valueStr);
             }
+        });
+        return resultVec;
+    }
+
+    // The name set by `env()`, or the long name with the prefix from `setEnvPrefix()`
+    HelpText envHelpStr(std::string_view longOpt) {
+        if (!envName_.empty()) { return std::move(envName_); }
+        if (envPrefix_.empty() || longOpt.size() <= 2) { return HelpText(); }
+
+        std::string name(envPrefix_);
+        for (char ch : longOpt.substr(2)) {
+            name.push_back(ch == '-' ? '_' : static_cast<char>(std::toupper(static_cast<unsigned char>(ch))));
         }
+        return name;
+    }
 
-        return resultVec;
+    // Calls the default function at most once
+    T getDefault() {
+        if (defaultFn_) {
+            defaultValue_ = defaultFn_();
+            defaultFn_    = nullptr;
+        }
+        return defaultValue_;
     }
 
-private:
-    std::string_view optName_;
-    std::string      description_;
-    std::string      typeName_;
-    InternalData    &data_;
-    const SubParser *passedSubCmd_{nullptr};
-    T                defaultValue_{};
-    bool             isRequied_{false};
+    HelpText defaultHelpStr() {
+        if (!defaultFn_) { return toString(defaultValue_); }
+        if (!defaultStr_.empty()) { return std::move(defaultStr_); }
+        // The help message is the only user of the string
+        if (!data_.helpRequested) { return HelpText(); }
+        return toString(getDefault());
+    }
+
+    std::string_view   optName_;
+    HelpText           description_;
+    HelpText           typeName_;
+    HelpText           defaultStr_;
+    HelpText           envName_;
+    InternalData      &data_;
+    const SubParser   *passedSubCmd_{nullptr};
+    T                  defaultValue_{};
+    std::function<T()> defaultFn_;
+    bool               isRequied_{false};
 };
 
 // === Positional Args ===
 
-inline std::string Parser::getPositional_(
+template <typename T>
+inline T Parser::getPositional_(
     const std::string &posName, std::string description, bool isRequired,
-    std::string defaultValue, InternalData &data) {
+    T defaultValue, InternalData &data) {
 
-    fixPositionalArgsArray(data.positionalArgsIndices, data.options);
+    HelpStr defaultValueStr{};
+    if constexpr (std::is_same_v<T, std::string>) {
+        defaultValueStr = copyHelpStr(defaultValue, data);
+    } else if (!isRequired) {
+        defaultValueStr = copyHelpStr(toString(defaultValue), data);
+    }
+    data.positionalHelpEntries.push_back({copyHelpStr(posName, data), copyHelpStr(description, data), defaultValueStr, isRequired, false});
 
-    data.positionalHelpEntries.push_back({posName, std::move(description), defaultValue, isRequired});
+    // Only the declaration is needed for the help message
+    if (data.helpRequested) { return defaultValue; }
 
-    if (data.positionalIdx < data.positionalArgsIndices.size()) {
+    fixPositionalArgsArray(data.positionalArgsIndices, data.options);
+
+    bool found  = data.positionalIdx < data.positionalArgsIndices.size();
+    T    result = defaultValue;
+    if (found) {
         int argvIdx = data.positionalArgsIndices[data.positionalIdx];
         data.positionalIdx++;
-        return argv_[argvIdx];
+
+        T value{};
+        if (convertType(argv_[argvIdx], value)) {
+            result = std::move(value);
+        } else {
+            appendPosConvErrorMsg(data, argvIdx, getTypeName<T>());
+        }
+    } else if (isRequired) {
+        appendPosValErrorMsg(data);
     }
 
-    if (isRequired) {
-        appendPosValErrorMsg(data, posName, "Missing required positional argument '");
+    if (isRecording()) {
+        recordItem(data, {}, posName, found ? 1 : 0);
+        recordValueOf(data, result);
     }
-    return defaultValue;
+    return result;
 }
 
-inline std::vector<std::string> Parser::getRemainingPositionals_(
+template <typename T>
+inline std::vector<T> Parser::getRemainingPositionals_(
     const std::string &posName, std::string description, bool required,
-    const std::vector<std::string> &defaultValue, InternalData &data) {
+    const std::vector<T> &defaultValue, InternalData &data) {
+
+    auto name = copyHelpStr(posName, data);
+    auto desc = copyHelpStr(description, data);
+
+    // Construct the default value string in the help arena, only strings are quoted
+    constexpr bool isString = std::is_same_v<T, std::string>;
+    HelpStr        defaultValueStr{};
+    if (!defaultValue.empty()) {
+        auto offset = data.helpArena.size();
+        data.helpArena.append(isString ? "[\"" : "[");
+        for (size_t i = 0; i < defaultValue.size(); i++) {
+            if (i != 0) { data.helpArena.append(isString ? "\", \"" : ", "); }
+            data.helpArena.append(toString(defaultValue[i]));
+        }
+        data.helpArena.append(isString ? "\"]" : "]");
+        defaultValueStr = {nullptr, static_cast<std::uint32_t>(offset), static_cast<std::uint32_t>(data.helpArena.size() - offset)};
+    }
 
-    fixPositionalArgsArray(data.positionalArgsIndices, data.options);
+    data.positionalHelpEntries.push_back({name, desc, defaultValueStr, required, true});
 
-    // Construct the default value string
-    std::string defaultValueStr("[\"");
-    for (unsigned long long i = 0; i < defaultValue.size(); i++) {
-        if (i != 0) { defaultValueStr.append("\", \""); }
-        defaultValueStr.append(defaultValue[i]);
-    }
-    defaultValueStr.append("\"]");
-    if (defaultValue.empty()) { defaultValueStr.clear(); }
+    if (data.helpRequested) { return defaultValue; }
 
-    data.positionalHelpEntries.push_back({posName, std::move(description), std::move(defaultValueStr), required, true});
+    fixPositionalArgsArray(data.positionalArgsIndices, data.options);
 
-    std::vector<std::string> remaining;
+    // Convert straight from argv into the reserved result
+    auto           count = data.positionalArgsIndices.size() - std::min(data.positionalIdx, data.positionalArgsIndices.size());
+    std::vector<T> remaining;
+    remaining.reserve(count);
+    bool hasInvalidValue = false;
     while (data.positionalIdx < data.positionalArgsIndices.size()) {
         int argvIdx = data.positionalArgsIndices[data.positionalIdx];
-        remaining.emplace_back(argv_[argvIdx]);
         data.positionalIdx++;
+
+        T result{};
+        if (convertType(argv_[argvIdx], result)) {
+            remaining.push_back(std::move(result));
+        } else {
+            appendPosConvErrorMsg(data, argvIdx, getTypeName<T>());
+            hasInvalidValue = true;
+        }
     }
 
-    if (remaining.empty()) {
+    if (remaining.empty() && !hasInvalidValue) {
         if (required) {
-            appendPosValErrorMsg(data, posName, "Missing required positional arguments '");
+            appendPosValErrorMsg(data);
         } else {
-            return defaultValue;
+            remaining = defaultValue;
+        }
+    }
+
+    if (isRecording()) {
+        recordItem(data, {}, posName, static_cast<unsigned>(count));
+        for (const auto &value : remaining) { recordValueOf(data, value); }
+    }
+    return remaining;
+}
+
+inline Parser::ArgvSpan Parser::getRemainingPositionalsInPlace_(
+    char **argv, const std::string &posName, std::string description, bool required, InternalData &data) {
+
+    data.positionalHelpEntries.push_back({copyHelpStr(posName, data), copyHelpStr(description, data), {}, required, true});
+
+    if (data.helpRequested) { return {argv_ + argc_, 0}; }
+
+    if (argv != argv_) {
+        if (embedded_) {
+            pushCustomError("[ArgLite] The argv of getRemainingPositionalsInPlace must be the one passed to preprocess.");
+            return {argv_ + argc_, 0};
         }
+        errSink_.write("[ArgLite] Error: The argv of getRemainingPositionalsInPlace must be the one passed to preprocess.\n");
+        std::exit(EXIT_FAILURE);
+    }
+
+    permuteArgv(argv, data);
+
+    // The remaining positional arguments are contiguous at the end of argv now
+    auto count = data.positionalArgsIndices.size() - std::min(data.positionalIdx, data.positionalArgsIndices.size());
+    data.positionalIdx += count;
+    ArgvSpan remaining{argv_ + argc_ - count, count};
+
+    if (remaining.empty() && required) { appendPosValErrorMsg(data); }
+
+    if (isRecording()) {
+        recordItem(data, {}, posName, static_cast<unsigned>(count));
+        for (const char *value : remaining) { recordValue(data, value); }
     }
     return remaining;
 }
 
-inline void Parser::appendPosValErrorMsg(
-    InternalData &data, std::string_view posName, std::string errorMsg) {
+// Moves the positional arguments to the end of argv, keeping the order of both groups,
+// and updates the indices that refer to the moved arguments
+inline void Parser::permuteArgv(char **argv, InternalData &data) {
+    fixPositionalArgsArray(data.positionalArgsIndices, data.options);
 
-    errorMsg.append(Formatter::bold(posName));
-    errorMsg.append("'.");
-    data.errorMessages.push_back(std::move(errorMsg));
+    auto &positionals = data.positionalArgsIndices;
+    auto  count       = static_cast<int>(positionals.size());
+    if (count == 0 || positionals.front() == argc_ - count) { return; } // Already at the end
+
+    // One pass that compacts the options and sets the positional arguments aside.
+    // The buffer keeps its capacity in the embedded mode, so repeated parses don't allocate
+    auto &moved = data.permuteBuffer;
+    moved.clear();
+    moved.reserve(positionals.size());
+    int writeIdx = positionals.front();
+    for (int i = writeIdx, p = 0; i < argc_; i++) {
+        if (p < count && positionals[p] == i) {
+            moved.push_back(argv[i]);
+            p++;
+        } else {
+            argv[writeIdx++] = argv[i];
+        }
+    }
+    std::copy(moved.begin(), moved.end(), argv + writeIdx);
+
+    // An option argument moves back by the number of positional arguments before it,
+    // the positional arguments keep their order after the options
+    auto newIndex = [&positionals, count](int idx) {
+        auto it   = std::lower_bound(positionals.begin(), positionals.end(), idx);
+        auto rank = static_cast<int>(it - positionals.begin());
+        if (it != positionals.end() && *it == idx) { return argc_ - count + rank; }
+        return idx - rank;
+    };
+    for (auto &option : data.options) {
+        for (auto &optInfo : option.second) {
+            if (optInfo.argvIndex < 0) {
+                optInfo.argvIndex = -newIndex(-optInfo.argvIndex);
+            } else if (optInfo.argvIndex > 0) {
+                optInfo.argvIndex = newIndex(optInfo.argvIndex);
+            }
+        }
+    }
+    for (auto &error : data.errors) {
+        if (error.argvIndex > 0) { error.argvIndex = newIndex(error.argvIndex); }
+    }
+    for (int p = 0; p < count; p++) { positionals[p] = argc_ - count + p; }
+}
+
+// The positional handle is the index of its help entry, which is pushed before the argument is parsed
+inline void Parser::appendPosValErrorMsg(InternalData &data) {
+    auto handle = static_cast<std::uint32_t>(data.positionalHelpEntries.size() - 1);
+    pushError(data, {ErrorCode::MissingPositional, handle, -1, {}, {}});
 }
 
+inline void Parser::appendPosConvErrorMsg(InternalData &data, int argvIndex, std::string_view typeName) {
+    auto handle = static_cast<std::uint32_t>(data.positionalHelpEntries.size() - 1);
+    pushError(data, {ErrorCode::InvalidPositional, handle, argvIndex, argv_[argvIndex], typeName});
+}
+
+// Errors are still recorded in help mode, as a later option named -h or --help can end it.
+// The messages are only rendered if no help message is printed
+inline void Parser::pushError(InternalData &data, const ParseError &error) { data.errors.push_back(error); }
+
 inline void Parser::fixPositionalArgsArray(
-    std::vector<int> &positionalArgsIndices, OptMap &options) {
+    Vector<int> &positionalArgsIndices, OptMap &options) {
 
     for (auto &option : options) {
         auto &optInfoArr = option.second;
         for (auto &it : optInfoArr) {
-            if (it.argvIndex > 0) { // Unrecognized option that consumed a positional arg
+            // Unrecognized option that consumed a positional arg, values in the option arg are not positional
+            if (it.argvIndex > 0 && it.valueOffset == 0) {
                 positionalArgsIndices.push_back(it.argvIndex);
-                it.argvIndex = 0; // Remove the option from the options_ map
+                it.argvIndex = 1 - it.argvIndex; // It was a flag, in the argument before the value
             }
         }
     }
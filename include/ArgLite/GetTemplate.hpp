@@ -1,76 +1,157 @@
 #pragma once
 
 #include "Core.hpp"
-#include <sstream>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
 #include <type_traits>
+#ifndef ARGLITE_NO_IOSTREAM
+#include <sstream>
+#endif
 
 namespace ArgLite {
 
-template <> inline std::string        Parser::convertType(const std::string &valueStr) { return valueStr; }
-template <> inline int                Parser::convertType(const std::string &valueStr) { return std::stoi(valueStr); }
-template <> inline long               Parser::convertType(const std::string &valueStr) { return std::stol(valueStr); }
-template <> inline long long          Parser::convertType(const std::string &valueStr) { return std::stoll(valueStr); }
-template <> inline unsigned int       Parser::convertType(const std::string &valueStr) { return std::stoul(valueStr); }
-template <> inline unsigned long      Parser::convertType(const std::string &valueStr) { return std::stoul(valueStr); }
-template <> inline unsigned long long Parser::convertType(const std::string &valueStr) { return std::stoull(valueStr); }
-template <> inline float              Parser::convertType(const std::string &valueStr) { return std::stof(valueStr); }
-template <> inline double             Parser::convertType(const std::string &valueStr) { return std::stod(valueStr); }
-
-template <> inline bool Parser::convertType(const std::string &valueStr) {
-    auto valStrCopy = valueStr;
-    std::transform(valStrCopy.begin(), valStrCopy.end(), valStrCopy.begin(),
-                   [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+// Parses an integer like `std::stoi` does: leading whitespace is skipped,
+// a `+` sign is accepted and trailing characters are ignored. It does not throw.
+template <typename T>
+inline bool Parser::parseNumber(std::string_view valueStr, T &result, int base) {
+    auto *first = valueStr.data();
+    auto *last  = valueStr.data() + valueStr.size();
+    while (first != last && std::isspace(static_cast<unsigned char>(*first)) != 0) { ++first; }
+    if (first != last && *first == '+') {
+        ++first;
+        if (first != last && *first == '-') { return false; }
+    }
 
-    if (valStrCopy == "true" || valStrCopy == "1" || valStrCopy == "yes" || valStrCopy == "on") {
+    if constexpr (std::is_integral_v<T>) {
+        if (base == 16 && last - first > 2 && first[0] == '0' && (first[1] == 'x' || first[1] == 'X')) { first += 2; }
+        return std::from_chars(first, last, result, base).ec == std::errc();
+    } else {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        (void)base;
+        return std::from_chars(first, last, result).ec == std::errc();
+#else
+        // strtod needs a null-terminated string
+        std::string copy(first, last);
+        char       *end = nullptr;
+        errno           = 0;
+        auto value      = std::strtold(copy.c_str(), &end);
+        if (end == copy.c_str() || errno == ERANGE) { return false; }
+        result = static_cast<T>(value);
         return true;
+#endif
     }
-    if (valStrCopy == "false" || valStrCopy == "0" || valStrCopy == "no" || valStrCopy == "off") {
-        return false;
-    }
-
-    throw std::invalid_argument("Invalid boolean value: " + valueStr);
-    return false; // Should not reach here
 }
 
-template <> inline char Parser::convertType(const std::string &valueStr) {
-    if (valueStr.empty()) { throw std::invalid_argument("Empty string"); }
-    if (valueStr.size() == 1) { return valueStr[0]; }
-    return valueStr.substr(0, 2) == "0x"
-               ? (char)std::stoul(valueStr, nullptr, 16) // NOLINT(readability-magic-numbers)
-               : (char)std::stoi(valueStr);
-}
+template <typename T>
+inline bool Parser::convertType(std::string_view valueStr, T &result) {
+    using DecayedT = remove_cvref_t<T>;
 
-template <typename T> inline T Parser::convertType(const std::string &valueStr) {
     if constexpr (isOptionalType<T>::value) {
-        return convertType<typename T::value_type>(valueStr);
+        typename T::value_type value{};
+        if (!convertType(valueStr, value)) { return false; }
+        result = std::move(value);
+        return true;
+    } else if constexpr (std::is_same_v<DecayedT, std::string>) {
+        result.assign(valueStr);
+        return true;
+    } else if constexpr (std::is_same_v<DecayedT, std::string_view>) {
+        result = valueStr; // A view of argv, the environment or the config file mapping
+        return true;
+    } else if constexpr (std::is_same_v<DecayedT, bool>) {
+        auto equals = [valueStr](std::string_view word) {
+            return valueStr.size() == word.size() &&
+                   std::equal(valueStr.begin(), valueStr.end(), word.begin(), [](char a, char b) {
+                       return std::tolower(static_cast<unsigned char>(a)) == b;
+                   });
+        };
+
+        if (equals("true") || equals("1") || equals("yes") || equals("on")) {
+            result = true;
+            return true;
+        }
+        if (equals("false") || equals("0") || equals("no") || equals("off")) {
+            result = false;
+            return true;
+        }
+        return false;
+    } else if constexpr (std::is_same_v<DecayedT, char>) {
+        if (valueStr.empty()) { return false; }
+        if (valueStr.size() == 1) {
+            result = valueStr[0];
+            return true;
+        }
+        int  code   = 0;
+        bool isHex  = valueStr.substr(0, 2) == "0x";
+        bool parsed = parseNumber(valueStr, code, isHex ? 16 : 10); // NOLINT(readability-magic-numbers)
+        result      = static_cast<char>(code);
+        return parsed;
+    } else if constexpr (std::is_integral_v<DecayedT> || std::is_floating_point_v<DecayedT>) {
+        return parseNumber(valueStr, result);
     } else {
-        return T(valueStr); // remaining types
+        // Remaining types are constructed from the string, they may throw
+        try {
+            result = T(std::string(valueStr));
+            return true;
+        } catch (...) {
+            return false;
+        }
     }
 }
 // End of convertType<T>
 
 template <typename T>
 inline std::string Parser::toString(const T &val) {
+    using DecayedT = remove_cvref_t<T>;
+
     if constexpr (isOptionalType<T>::value) {
         if (val) {
             return toString(*val);
         }
         return "None";
+    } else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+        return std::string(std::string_view(val));
+    } else if constexpr (std::disjunction_v<std::is_same<DecayedT, char>,
+                                            std::is_same<DecayedT, signed char>,
+                                            std::is_same<DecayedT, unsigned char>>) {
+        return std::string(1, static_cast<char>(val));
+    } else if constexpr (std::is_same_v<DecayedT, bool>) {
+        return val ? "1" : "0";
+    } else if constexpr (std::is_integral_v<DecayedT>) {
+        using WideT = std::conditional_t<std::is_signed_v<DecayedT>, long long, unsigned long long>;
+        char buf[32]; // NOLINT(readability-magic-numbers)
+        auto res = std::to_chars(buf, buf + sizeof(buf), static_cast<WideT>(val));
+        return std::string(buf, res.ptr);
+    } else if constexpr (std::is_floating_point_v<DecayedT>) {
+        // Same output as the default stream formatting, i.e., "%g"
+        char buf[64]; // NOLINT(readability-magic-numbers)
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto        res = std::to_chars(buf, buf + sizeof(buf), val, std::chars_format::general, 6);
+        std::string result(buf, res.ptr);
+#else
+        std::snprintf(buf, sizeof(buf), "%g", static_cast<double>(val));
+        std::string result(buf);
+#endif
+        if (result.find('.') == std::string::npos) {
+            result.append(".0");
+        }
+        return result;
     } else {
+#ifndef ARGLITE_NO_IOSTREAM
         std::stringstream ss;
         ss << val;
-        std::string result(ss.str());
-        if constexpr (std::is_floating_point_v<T>) {
-            if (result.find('.') == std::string::npos) {
-                result.append(".0");
-            }
-        }
-        return result;
+        return ss.str();
+#else
+        return {}; // Custom types have no textual form without iostreams, so no default value is shown
+#endif
     }
 }
 
 template <typename T>
-std::string Parser::getTypeName() {
+std::string_view Parser::getTypeName() {
     // Remove const, volatile qualifiers and references for consistent type comparison
     using DecayedT = remove_cvref_t<T>;
 
@@ -121,7 +202,7 @@ std::string Parser::getTypeName() {
         return "bool";
     }
     // Specific type for std::string
-    else if constexpr (std::is_same_v<DecayedT, std::string>) {
+    else if constexpr (std::disjunction_v<std::is_same<DecayedT, std::string>, std::is_same<DecayedT, std::string_view>>) {
         return "string";
     }
     // For any other types (e.g., void, nullptr_t, pointers, custom structs), return an empty string
@@ -1,9 +1,12 @@
 #pragma once
 
+#ifdef ARGLITE_NO_IOSTREAM
+#error "ARGLITE_NO_IOSTREAM is only supported by the Full version (ArgLite/Core.hpp)"
+#endif
+
 #include <algorithm>
 #include <cstddef>
 #include <cstdlib>
-#include <iomanip>
 #include <iostream>
 #include <string>
 #include <string_view>
@@ -12,6 +15,7 @@
 #include <vector>
 
 #include "Formatter.hpp"
+#include "MinimalCommon.hpp"
 
 namespace ArgLite {
 
@@ -221,13 +225,18 @@ private:
     };
 
     struct OptionHelpInfo {
-        std::string shortOpt; // Prepended with "-"
-        std::string longOpt;  // Prepended with "--"
+        char        shortOpt; // Without "-", '\0' if there is no short option
+        std::string longOpt;  // Without "--", the header text if it is an option header
         std::string description;
         std::string defaultValue;
         std::string typeName;
         bool        isMutualExDefault;
-        bool        isOptHeader; // The first member (shortOpt) will be an option header if it is true
+        bool        isOptHeader;
+
+        template <typename Out>
+        void printDefault(Out &out) const {
+            if (!defaultValue.empty()) { out << " [default: " << defaultValue << ']'; }
+        }
     };
 
     struct PositionalHelpInfo {
@@ -236,6 +245,11 @@ private:
         std::string defaultValue;
         bool        isRequired;
         bool        isRemaining;
+
+        template <typename Out>
+        void printDefault(Out &out) const {
+            if (!defaultValue.empty()) { out << " [default: " << defaultValue << ']'; }
+        }
     };
 
     using OptMap = std::unordered_map<std::string, OptionInfo>;
@@ -255,6 +269,27 @@ private:
         std::vector<std::string>        errorMessages;
     };
 
+    // Writes the help message to a stream, see MinimalCommon for the interface
+    class StreamWriter {
+    public:
+        explicit StreamWriter(std::ostream &os) : os_(os) {}
+
+        template <typename T>
+        StreamWriter &operator<<(const T &val) {
+            os_ << val;
+            return *this;
+        }
+
+        void pad(size_t count) {
+            for (size_t i = 0; i < count; i++) { os_.put(' '); }
+        }
+
+        Formatter::Styled styled(std::string_view sv, Formatter::Style style) const { return Formatter::styled(sv, style, os_); }
+
+    private:
+        std::ostream &os_;
+    };
+
     // Internal data storage
     static inline int                argc_;
     static inline const char *const *argv_;
@@ -280,10 +315,10 @@ private:
     template <typename T>
     static inline std::string toString(const T &val);
     // Helper functions for get functions with long return types
-    static inline std::string                         parseOptName(std::string_view optName);
-    static inline std::pair<std::string, std::string> parseOptNameAsPair(std::string_view optName);
-    static inline OptMap::node_type                   findOption(const std::string &shortOpt, const std::string &longOpt, InternalData &data);
-    static inline std::pair<bool, std::string>        getValueStr(std::string_view optName, const std::string &description, const std::string &defaultValueStr, const std::string &typeName, InternalData &data);
+    static inline std::string                  parseOptName(std::string_view optName);
+    static inline OptionHelpInfo              &pushOptionHelp(InternalData &data, std::string_view optName, const std::string &description);
+    static inline OptMap::node_type            findOption(const OptionHelpInfo &helpInfo, InternalData &data);
+    static inline std::pair<bool, std::string> getValueStr(std::string_view optName, const std::string &description, const std::string &defaultValueStr, const std::string &typeName, InternalData &data);
     // Other helper functions
     static inline void setDescription_(std::string_view description, InternalData &data);
     static inline void setShortNonFlagOptsStr_(std::string_view shortNonFlagOptsStr, InternalData &data);
@@ -292,27 +327,14 @@ private:
     static inline void tryToPrintHelp_(InternalData &data);
     static inline bool tryToPrintInvalidOpts_(InternalData &data, bool notExit = false);
     static inline void printHelp(const InternalData &data);
-    static inline void printHelpDescription(std::string_view description);
-    static inline void printHelpUsage(const InternalData &data, std::string_view cmdName);
-    static inline void printHelpPositional(const InternalData &data);
-    static inline void printHelpOptions(const InternalData &data);
     static inline void clearData(InternalData &data);
     static inline bool finalize_(InternalData &data, bool notExit = false);
     static inline bool runAllPostprocess_(InternalData &data, bool notExit = false);
     // Other functions
     static void insertOptHeader_(std::string header) {
         data_.hasCustumOptHeader = true;
-        data_.optionHelpEntries.push_back({std::move(header), "", "", "", "", false, true});
+        data_.optionHelpEntries.push_back({'\0', std::move(header), "", "", "", false, true});
     }
-
-    // Formatter-related
-#ifdef ARGLITE_ENABLE_FORMATTER
-    constexpr static int            ANSI_CODE_LENGTH = 8; // 4 + 4 (\x1b[1m + \x1b[0m))
-    static inline const std::string ERROR_STR        = Formatter::red("Error: ");
-#else
-    constexpr static int            ANSI_CODE_LENGTH = 0;
-    static inline const std::string ERROR_STR        = "Error: ";
-#endif
 }; // class Parser
 
 // === Private Helper Implementations ===
@@ -325,116 +347,34 @@ inline void Parser::setShortNonFlagOptsStr_(std::string_view shortNonFlagOptsStr
     data.shortNonFlagOptsStr = shortNonFlagOptsStr;
 }
 
-inline void Parser::preprocess_(int argc, const char *const *argv) { // NOLINT(readability-function-cognitive-complexity)
+inline void Parser::preprocess_(int argc, const char *const *argv) {
     argc_ = argc;
     argv_ = argv;
 
     auto &data = data_;
 
-    if (argc_ > 0) {
-        data.programName = argv[0];
-
-        // Extract the basename
-        if (auto last_slash_pos = data.programName.find_last_of("/\\");
-            std::string::npos != last_slash_pos) {
-            data.programName.erase(0, last_slash_pos + 1);
-        }
-    }
-
-    bool allPositional = false;
-    for (int i = 1; i < argc; ++i) {
-        std::string arg = argv[i];
-
-        if (allPositional) {
-            data.positionalArgsIndices.push_back(i);
-            continue;
-        }
-
-        if (arg.length() <= 1) { // Not an option, an option has 2 chars at least (e.g., -h)
-            data.positionalArgsIndices.push_back(i);
-            continue;
-        }
+    if (argc_ > 0) { data.programName = MinimalCommon::baseName(argv[0]); }
 
-        if (arg == "--") {
-            allPositional = true;
-            continue;
-        }
+    struct Store {
+        InternalData &data;
 
-        // Long option
-        if (arg.rfind("--", 0) == 0) {
-            std::string key = arg;
+        void pushPositional(int argvIndex) { data.positionalArgsIndices.push_back(argvIndex); }
+        void setOption(std::string_view key, int argvIndex, size_t valueOffset) {
             std::string value;
-            // --opt=val form
-            if (auto equalsPos = arg.find('='); equalsPos != std::string::npos) {
-                key               = arg.substr(0, equalsPos);
-                value             = arg.substr(equalsPos + 1);
-                data.options[key] = {i, std::move(value)};
-            } else {
-                if (i + 1 < argc && argv[i + 1][0] != '-') {
-                    data.options[key] = {i + 1, ""};
-                    i++; // Consume next arg as value
-                } else {
-                    data.options[key] = {-i, ""}; // Flag
-                }
-            }
+            if (valueOffset != 0) { value = argv_[argvIndex] + valueOffset; } // From -n123 or --opt=val form
+            data.options[std::string(key)] = {argvIndex, std::move(value)};
         }
-        // Short option(s)
-        // Process short options, e.g., -n 123, -ab, -abn 123, -n123, -abn123
-        else if (arg.rfind('-', 0) == 0) {
-            std::string lastFlagKey;
-            bool        isValueConsumedInCurrentArg = false; // True if a short option like -n123 was found
-
-            for (size_t j = 1; j < arg.length(); ++j) {
-                std::string currentOptKey = "-";
-                currentOptKey += arg[j];
-
-                // Check if the current character is a short option that requires a value
-                if (data.shortNonFlagOptsStr.find(arg[j]) != std::string::npos && j + 1 < arg.length()) {
-                    // `-n123` or `-abn123` form. It requires a value, the rest of the string is its value
-                    std::string value           = arg.substr(j + 1);
-                    data.options[currentOptKey] = {i, std::move(value)};
-                    isValueConsumedInCurrentArg = true;
-                    break; // Stop processing this argument, as the rest is a value for this option
-                }
-
-                // It's a flag
-                auto node = data.options.extract(currentOptKey);
-                // Try to restore the positional argument if it was consumed by a flag
-                if (!node.empty()) {
-                    auto argvIndex = node.mapped().argvIndex;
-                    if (argvIndex > 0) {
-                        data.positionalArgsIndices.push_back(argvIndex);
-                    }
-                }
-                // Add or update the option
-                data.options[currentOptKey] = {-i, ""};
-                // Keep track of the last flag, in case it needs to consume the next argument
-                lastFlagKey = currentOptKey;
-            }
-
-            // `-n 123` or `-abn 123` form
-            // If no value was consumed within the current argument (not `-n123` form)
-            // and there was a last flag, check if it takes a value from the next argument.
-            if (!isValueConsumedInCurrentArg && !lastFlagKey.empty()) {
-                // This condition applies to the *last* flag in a bundle (e.g., 'c' in -abc)
-                // or a single short option (e.g., 'a' in -a).
-                // If the next argument exists and is not another option, it's the value.
-                if (i + 1 < argc && argv[i + 1][0] != '-') {
-                    data.options[lastFlagKey] = {i + 1, ""};
-                    i++; // Consume the next argument
-                }
-            }
+        int consumedIndex(std::string_view key) const {
+            auto it = data.options.find(std::string(key));
+            return it != data.options.end() ? it->second.argvIndex : 0;
         }
-        // Positional
-        else {
-            data.positionalArgsIndices.push_back(i);
-        }
-    }
+    } store{data};
+    MinimalCommon::scanArgs(argc, argv, data.shortNonFlagOptsStr, store);
 }
 
 inline void Parser::tryToPrintVersion_(InternalData &data) {
     if (programVersion_.empty()) { return; }
-    data.optionHelpEntries.push_back({"-V", "--version", "Show version information and exit", ""});
+    data.optionHelpEntries.push_back({'V', "version", "Show version information and exit"});
     if ((data.options.count("-V") != 0) || (data.options.count("--version")) != 0) {
         std::cout << programVersion_ << '\n';
         std::exit(EXIT_SUCCESS);
@@ -445,7 +385,7 @@ inline void Parser::tryToPrintHelp_(InternalData &data) {
     tryToPrintVersion_(data);
 
     if ((data.options.count("-h") != 0) || (data.options.count("--help")) != 0) {
-        data.optionHelpEntries.push_back({"-h", "--help", "Show this help message and exit", ""});
+        data.optionHelpEntries.push_back({'h', "help", "Show this help message and exit"});
         printHelp(data);
         std::exit(EXIT_SUCCESS);
     }
@@ -457,9 +397,10 @@ inline bool Parser::tryToPrintInvalidOpts_(InternalData &data, bool notExit) {
     data.options.erase("--help");
 
     if (!data.options.empty()) {
+        auto errorStr = Formatter::styled("Error: ", Formatter::Style::Red, std::cerr);
         for (const auto &pair : data.options) {
-            std::cerr << ERROR_STR << "Unrecognized option '";
-            std::cerr << Formatter::bold(pair.first);
+            std::cerr << errorStr << "Unrecognized option '";
+            std::cerr << Formatter::styled(pair.first, Formatter::Style::Bold, std::cerr);
             std::cerr << "'\n";
         }
         if (!notExit) { std::exit(EXIT_FAILURE); }
@@ -470,115 +411,10 @@ inline bool Parser::tryToPrintInvalidOpts_(InternalData &data, bool notExit) {
 }
 
 inline void Parser::printHelp(const InternalData &data) {
-    printHelpDescription(data_.programDescription);
-    printHelpUsage(data, data_.programName);
-    printHelpPositional(data);
-    printHelpOptions(data);
-
-    if (!data.helpFooter.empty()) {
-        std::cout << '\n'
-                  << data.helpFooter << '\n';
-    }
-}
-
-inline void Parser::printHelpDescription(std::string_view description) {
-    if (!description.empty()) {
-        std::cout << description << '\n'
-                  << '\n';
-    }
-}
-
-inline void Parser::printHelpUsage(const InternalData &data, std::string_view cmdName) {
-    std::cout << "Usage: ";
-    std::cout << Formatter::bold(cmdName);
-    if (!data.optionHelpEntries.empty()) std::cout << " [OPTIONS]";
-    for (const auto &p : data.positionalHelpEntries) {
-        std::cout << " " << (p.isRequired ? "" : "[") << p.name << (p.isRequired ? "" : "]");
-        if (p.isRemaining) { std::cout << "..."; }
-    }
-    std::cout << '\n';
-}
-
-inline void Parser::printHelpPositional(const InternalData &data) {
-    if (data.positionalHelpEntries.empty()) { return; }
-
-    // Print header
-    std::cout << '\n'
-              << Formatter::boldUnderline("Positional Arguments:") << '\n';
-
-    size_t maxNameWidth = 0;
-    for (const auto &p : data.positionalHelpEntries) {
-        maxNameWidth = std::max(maxNameWidth, p.name.length());
-    }
-    // Print each positional argument
-    for (const auto &p : data.positionalHelpEntries) {
-        // Print name
-        std::cout << "  " << std::left;
-        std::cout << std::setw(static_cast<int>(maxNameWidth) + 2 + ANSI_CODE_LENGTH)
-                  << Formatter::bold(p.name);
-
-        // Print description
-        std::string descStr = p.description;
-        if (!p.defaultValue.empty()) {
-            descStr.append(" [default: ").append(p.defaultValue).append("]");
-        }
-        std::cout << descStr << '\n';
-    }
-}
-
-inline void Parser::printHelpOptions(const InternalData &data) {
-    if (data.optionHelpEntries.empty()) { return; }
-
-    // Print header
-    if (!data.hasCustumOptHeader) {
-        std::cout << '\n'
-                  << Formatter::boldUnderline("Options:") << '\n';
-    }
-
-    // Print each option
-    for (const auto &o : data.optionHelpEntries) {
-        // It is a option header
-        if (o.isOptHeader) {
-            std::cout << '\n';
-            std::cout << Formatter::boldUnderline(o.shortOpt + ":\n");
-            continue;
-        }
-
-        // Print name
-        std::string optStr("  ");
-        if (!o.shortOpt.empty()) {
-            optStr += o.shortOpt;
-            if (!o.longOpt.empty()) { optStr += ", "; }
-        } else {
-            optStr += "    "; // Pad for alignment
-        }
-        optStr += o.longOpt;
-
-        std::cout << std::left;
-        std::cout << std::setw(static_cast<int>(descriptionIndent_) + ANSI_CODE_LENGTH);
-        optStr = Formatter::bold(optStr);
-
-        if (!o.typeName.empty()) {
-            optStr.append(" <").append(o.typeName).append(">");
-        }
-        std::cout << optStr;
-
-        // Print description
-        std::string descStr = o.description;
-        if (!o.defaultValue.empty()) {
-            descStr.append(" [default: ").append(o.defaultValue).append("]");
-        }
-        if (o.isMutualExDefault) { descStr.append(" (default)"); }
-        // the option string is too long, start a new line
-        // -2: two separeting spaces after the type name
-        auto optPartLength = optStr.length();
-        optPartLength -= ANSI_CODE_LENGTH;
-        if (optPartLength > descriptionIndent_ - 2) {
-            std::cout << '\n'
-                      << std::left << std::setw(static_cast<int>(descriptionIndent_)) << "";
-        }
-        std::cout << descStr << '\n';
-    }
+    StreamWriter out(std::cout);
+    MinimalCommon::printHelp(
+        out, {data.programDescription, data.programName, data.helpFooter, data.hasCustumOptHeader, descriptionIndent_},
+        data.optionHelpEntries, data.positionalHelpEntries);
 }
 
 // Clear internal data
@@ -604,8 +440,9 @@ inline bool Parser::finalize_(InternalData &data, bool notExit) {
 
     std::cerr << "Errors occurred while parsing command-line arguments.\n";
     std::cerr << "The following is a list of error messages:\n";
+    auto errorStr = Formatter::styled("Error: ", Formatter::Style::Red, std::cerr);
     for (const auto &msg : data.errorMessages) {
-        std::cerr << ERROR_STR << msg << '\n';
+        std::cerr << errorStr << msg << '\n';
     }
 
     if (notExit) {
@@ -0,0 +1,298 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "Formatter.hpp"
+
+namespace ArgLite {
+
+/**
+ * @brief The argument scanning and help layout shared by the Minimal parser and FixedParser.
+ * @details The parsers differ only in how they store options and help entries, so the code here
+ *          is written against small interfaces instead of containers:
+ *          - A store passed to `scanArgs` provides `pushPositional(int argvIndex)`,
+ *            `setOption(std::string_view key, int argvIndex, size_t valueOffset)` and
+ *            `consumedIndex(std::string_view key)`.
+ *          - A writer passed to the help functions provides `<<` for views, characters and
+ *            `Formatter::Styled`, `pad(size_t count)` and `styled(std::string_view, Formatter::Style)`.
+ *          - Option help entries have `shortOpt` (a character, '\0' if none), `longOpt` (without "--",
+ *            the header text if `isOptHeader`), `typeName`, `description`, `isMutualExDefault`, `isOptHeader`
+ *            and `printDefault(out)`. Positional help entries have `name`, `description`, `isRequired`,
+ *            `isRemaining` and `printDefault(out)`.
+ */
+class MinimalCommon {
+public:
+    // Short and long names of an option, e.g., "o,out" is split into 'o' and "out"
+    struct OptName {
+        char             shortOpt; // '\0' if there is no short option
+        std::string_view longOpt;  // Without "--", empty if there is no long option
+    };
+
+    // Views an array of help entries, for parsers that do not keep them in a container
+    template <typename T>
+    struct Span {
+        const T *first;
+        size_t   count;
+
+        [[nodiscard]] const T *begin() const { return first; }
+        [[nodiscard]] const T *end() const { return first + count; }
+        [[nodiscard]] bool     empty() const { return count == 0; }
+    };
+
+    // Splits option names (e.g., "o,out"), the names must not be empty
+    static OptName splitOptName(std::string_view optName) {
+        // Short option only
+        if (optName.length() == 1) { return {optName[0], {}}; }
+        // Long option only
+        if (optName[1] != ',') { return {'\0', optName}; }
+        // Short and long options combined
+        return {optName[0], optName.substr(2)};
+    }
+
+    // Keys of short options view this table, so bundled options (e.g., -ab) need no storage
+    static std::string_view shortOptKey(char ch) {
+        static constexpr auto TABLE = [] {
+            std::array<char, 256 * 2> table{};
+            for (size_t i = 0; i < 256; i++) {
+                table[i * 2]     = '-';
+                table[i * 2 + 1] = static_cast<char>(i);
+            }
+            return table;
+        }();
+        return {TABLE.data() + static_cast<size_t>(static_cast<unsigned char>(ch)) * 2, 2};
+    }
+
+    // Returns the program name without its directory
+    static std::string_view baseName(std::string_view path) {
+        if (auto lastSlashPos = path.find_last_of("/\\"); std::string_view::npos != lastSlashPos) {
+            path.remove_prefix(lastSlashPos + 1);
+        }
+        return path;
+    }
+
+    /**
+     * @brief Sorts the command-line arguments into options and positional arguments.
+     * @details An option is stored with the index of its value in argv, or the negative index of the option itself
+     *          if it is a flag. A positive `valueOffset` means the value is inside the option argument
+     *          (the -n123 and --opt=val forms).
+     */
+    template <typename Store>
+    static void scanArgs(int argc, const char *const *argv, std::string_view shortNonFlagOptsStr, Store &store) { // NOLINT(readability-function-cognitive-complexity)
+        bool allPositional = false;
+        for (int i = 1; i < argc; ++i) {
+            std::string_view arg = argv[i];
+
+            if (allPositional) {
+                store.pushPositional(i);
+                continue;
+            }
+
+            if (arg.length() <= 1) { // Not an option, an option has 2 chars at least (e.g., -h)
+                store.pushPositional(i);
+                continue;
+            }
+
+            if (arg == "--") {
+                allPositional = true;
+                continue;
+            }
+
+            // Long option
+            if (arg.rfind("--", 0) == 0) {
+                // --opt=val form
+                if (auto equalsPos = arg.find('='); equalsPos != std::string_view::npos) {
+                    store.setOption(arg.substr(0, equalsPos), i, equalsPos + 1);
+                } else {
+                    if (i + 1 < argc && argv[i + 1][0] != '-') {
+                        store.setOption(arg, i + 1, 0);
+                        i++; // Consume next arg as value
+                    } else {
+                        store.setOption(arg, -i, 0); // Flag
+                    }
+                }
+            }
+            // Short option(s)
+            // Process short options, e.g., -n 123, -ab, -abn 123, -n123, -abn123
+            else if (arg.rfind('-', 0) == 0) {
+                std::string_view lastFlagKey;
+                bool             isValueConsumedInCurrentArg = false; // True if a short option like -n123 was found
+
+                for (size_t j = 1; j < arg.length(); ++j) {
+                    auto currentOptKey = shortOptKey(arg[j]); // "-" and the option character
+
+                    // Check if the current character is a short option that requires a value
+                    if (shortNonFlagOptsStr.find(arg[j]) != std::string_view::npos && j + 1 < arg.length()) {
+                        // `-n123` or `-abn123` form. It requires a value, the rest of the string is its value
+                        store.setOption(currentOptKey, i, j + 1);
+                        isValueConsumedInCurrentArg = true;
+                        break; // Stop processing this argument, as the rest is a value for this option
+                    }
+
+                    // It's a flag
+                    // Try to restore the positional argument if it was consumed by a flag
+                    if (int consumed = store.consumedIndex(currentOptKey); consumed > 0) {
+                        store.pushPositional(consumed);
+                    }
+                    // Add or update the option
+                    store.setOption(currentOptKey, -i, 0);
+                    // Keep track of the last flag, in case it needs to consume the next argument
+                    lastFlagKey = currentOptKey;
+                }
+
+                // `-n 123` or `-abn 123` form
+                // If no value was consumed within the current argument (not `-n123` form)
+                // and there was a last flag, check if it takes a value from the next argument.
+                if (!isValueConsumedInCurrentArg && !lastFlagKey.empty()) {
+                    // This condition applies to the *last* flag in a bundle (e.g., 'c' in -abc)
+                    // or a single short option (e.g., 'a' in -a).
+                    // If the next argument exists and is not another option, it's the value.
+                    if (i + 1 < argc && argv[i + 1][0] != '-') {
+                        store.setOption(lastFlagKey, i + 1, 0);
+                        i++; // Consume the next argument
+                    }
+                }
+            }
+            // Positional
+            else {
+                store.pushPositional(i);
+            }
+        }
+    }
+
+    // === Help message ===
+
+    // Program-wide parts of the help message
+    struct HelpLayout {
+        std::string_view programDescription;
+        std::string_view programName;
+        std::string_view helpFooter;
+        bool             hasCustomOptHeader;
+        size_t           descriptionIndent;
+    };
+
+    template <typename Out, typename OptRange, typename PosRange>
+    static void printHelp(Out &out, const HelpLayout &layout, const OptRange &options, const PosRange &positionals) {
+        if (!layout.programDescription.empty()) {
+            out << layout.programDescription << '\n'
+                << '\n';
+        }
+        printHelpUsage(out, layout.programName, !options.empty(), positionals);
+        printHelpPositional(out, positionals);
+        printHelpOptions(out, options, layout.hasCustomOptHeader, layout.descriptionIndent);
+
+        if (!layout.helpFooter.empty()) {
+            out << '\n'
+                << layout.helpFooter << '\n';
+        }
+    }
+
+    template <typename Out, typename PosRange>
+    static void printHelpUsage(Out &out, std::string_view programName, bool hasOptions, const PosRange &positionals) {
+        out << "Usage: " << out.styled(programName, Formatter::Style::Bold);
+        if (hasOptions) { out << " [OPTIONS]"; }
+        for (const auto &p : positionals) {
+            out << ' ' << (p.isRequired ? "" : "[") << p.name << (p.isRequired ? "" : "]");
+            if (p.isRemaining) { out << "..."; }
+        }
+        out << '\n';
+    }
+
+    template <typename Out, typename PosRange>
+    static void printHelpPositional(Out &out, const PosRange &positionals) {
+        if (positionals.empty()) { return; }
+
+        // Print header
+        out << '\n'
+            << out.styled("Positional Arguments:", Formatter::Style::BoldUnderline) << '\n';
+
+        size_t maxNameWidth = 0;
+        for (const auto &p : positionals) {
+            maxNameWidth = std::max(maxNameWidth, std::string_view(p.name).length());
+        }
+        // Print each positional argument
+        for (const auto &p : positionals) {
+            std::string_view name = p.name;
+            // Print name
+            out << "  " << out.styled(name, Formatter::Style::Bold);
+            out.pad(maxNameWidth + 2 - name.length());
+
+            // Print description
+            out << p.description;
+            p.printDefault(out);
+            out << '\n';
+        }
+    }
+
+    template <typename Out, typename OptRange>
+    static void printHelpOptions(Out &out, const OptRange &options, bool hasCustomOptHeader, size_t descriptionIndent) {
+        if (options.empty()) { return; }
+
+        // Print header
+        if (!hasCustomOptHeader) {
+            out << '\n'
+                << out.styled("Options:", Formatter::Style::BoldUnderline) << '\n';
+        }
+
+        // Print each option
+        for (const auto &o : options) {
+            std::string_view longOpt = o.longOpt;
+            // It is a option header
+            if (o.isOptHeader) {
+                out << '\n'
+                    << out.styled(longOpt, Formatter::Style::BoldUnderline) << ":\n";
+                continue;
+            }
+
+            // Print name, e.g., "  -o, --output", at most "  -x, --" + the long name
+            std::array<char, 8> prefix{};
+            size_t              prefixLen = 0;
+            for (char ch : {' ', ' '}) { prefix[prefixLen++] = ch; }
+            if (o.shortOpt != '\0') {
+                prefix[prefixLen++] = '-';
+                prefix[prefixLen++] = o.shortOpt;
+                if (!longOpt.empty()) {
+                    prefix[prefixLen++] = ',';
+                    prefix[prefixLen++] = ' ';
+                }
+            } else {
+                for (char ch : {' ', ' ', ' ', ' '}) { prefix[prefixLen++] = ch; } // Pad for alignment
+            }
+            if (!longOpt.empty()) {
+                prefix[prefixLen++] = '-';
+                prefix[prefixLen++] = '-';
+            }
+
+            out << out.styled(std::string_view(prefix.data(), prefixLen), Formatter::Style::Bold)
+                << out.styled(longOpt, Formatter::Style::Bold);
+
+            size_t           optPartLength = prefixLen + longOpt.length();
+            std::string_view typeName      = o.typeName;
+            if (!typeName.empty()) {
+                out << " <" << typeName << '>';
+                optPartLength += typeName.length() + 3;
+            }
+
+            // the option string is too long, start a new line
+            // -2: two separeting spaces after the type name
+            if (optPartLength > descriptionIndent - 2) {
+                out << '\n';
+                out.pad(descriptionIndent);
+            } else {
+                out.pad(descriptionIndent - optPartLength);
+            }
+
+            // Print description
+            out << o.description;
+            o.printDefault(out);
+            if (o.isMutualExDefault) { out << " (default)"; }
+            out << '\n';
+        }
+    }
+
+    MinimalCommon() = delete;
+};
+
+} // namespace ArgLite
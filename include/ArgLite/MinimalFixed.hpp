@@ -0,0 +1,940 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+#include "Formatter.hpp"
+#include "MinimalCommon.hpp"
+#include "OutputSink.hpp"
+
+namespace ArgLite {
+
+/**
+ * @brief A fixed-capacity build of the Minimal parser that never allocates on the heap.
+ * @details All internal data lives in static arrays sized by the template parameters.
+ *          Strings are viewed rather than copied, so descriptions, names, defaults, the version and the help footer
+ *          must outlive the parser (string literals always do). Values are returned as views into argv.
+ *          The interface follows the Minimal version, see the README for details.
+ * @tparam MaxOpts The maximum number of option help entries. Each hasFlag/get* call and each option header
+ *                 takes one entry, hasMutualExFlag takes two.
+ * @tparam MaxPositionals The maximum number of getPositional/getRemainingPositionals calls.
+ * @tparam MaxArgc The maximum number of command-line arguments (including the program name),
+ *                 which is also the maximum number of distinct options on the command line.
+ *                 Arguments beyond it are ignored and reported as an error.
+ */
+template <size_t MaxOpts, size_t MaxPositionals, size_t MaxArgc>
+class FixedParser {
+public:
+    /**
+     * @brief A list of positional argument values, returned by getRemainingPositionals.
+     * @details It views argv or the array of default values, and it is valid until the next `preprocess()` call.
+     */
+    class ArgList {
+    public:
+        class Iterator {
+        public:
+            Iterator(const ArgList *list, size_t idx) : list_(list), idx_(idx) {}
+            std::string_view operator*() const { return (*list_)[idx_]; }
+            Iterator        &operator++() {
+                idx_++;
+                return *this;
+            }
+            bool operator!=(const Iterator &other) const { return idx_ != other.idx_; }
+
+        private:
+            const ArgList *list_;
+            size_t         idx_;
+        };
+
+        ArgList() = default;
+
+        /**
+         * @brief Creates a list from an array of default values. The array must outlive the list.
+         */
+        template <size_t N>
+        ArgList(const std::string_view (&values)[N]) : values_(values), size_(N) {} // NOLINT(google-explicit-constructor)
+
+        [[nodiscard]] size_t   size() const { return size_; }
+        [[nodiscard]] bool     empty() const { return size_ == 0; }
+        [[nodiscard]] Iterator begin() const { return {this, 0}; }
+        [[nodiscard]] Iterator end() const { return {this, size_}; }
+
+        std::string_view operator[](size_t idx) const {
+            return indices_ != nullptr ? std::string_view(argv_[indices_[idx]]) : values_[idx];
+        }
+
+    private:
+        friend class FixedParser;
+
+        const char *const      *argv_    = nullptr;
+        const int              *indices_ = nullptr;
+        const std::string_view *values_  = nullptr;
+        size_t                  size_    = 0;
+    };
+
+    /**
+     * @brief Sets the program description, used for the first line of the help message.
+     * @param description The program's description text.
+     */
+    static void setDescription(std::string_view description) { data_.programDescription = description; }
+
+    /**
+     * @brief Sets the program version and add options `-V` and `--version` to print the version.
+     * @param versionStr The program's version string.
+     */
+    static void setVersion(std::string_view versionStr) { programVersion_ = versionStr; }
+
+    /**
+     * @brief Sets which short options require a value.
+     * @details To pass short options like `-n 123` as a single argument `-n123`,
+                provide the short option names as a string to this function.
+                You don't have to call it, but if you do, call it before `preprocess()`.
+     * @param shortNonFlagOptsStr A string containing all short option characters that require a value.
+                                  For example, if `-n` and `-r` require values, pass `nr`.
+     */
+    static void setShortNonFlagOptsStr(std::string_view shortNonFlagOptsStr) { data_.shortNonFlagOptsStr = shortNonFlagOptsStr; }
+
+    /**
+     * @brief Sets the sinks for the help, version and error output. Defaults are stdout and stderr.
+     * @details Sinks that append to a string allocate, use file descriptor or buffer sinks to stay heap-free.
+     * @param out The sink for the help message and the version.
+     * @param err The sink for error messages.
+     */
+    static void setOutput(OutputSink out, OutputSink err) {
+        outSink_ = out;
+        errSink_ = err;
+    }
+
+    /**
+     * @brief Preprocesses the command-line arguments. This is the first step in using this library.
+     * @param argc The argc from the main function.
+     * @param argv The argv from the main function.
+     */
+    static void preprocess(int argc, const char *const *argv) { preprocess_(argc, argv); }
+
+    /**
+     * @brief Checks if a flag option exists.
+     * @param optName Option names (e.g., "v", "verbose" or "v,verbose").
+     * @param description Option description, used for the help message.
+     * @return Returns true if the option appears in the command line, false otherwise.
+     */
+    static bool hasFlag(std::string_view optName, std::string_view description) { return hasFlag_(optName, description, data_); }
+
+    //  Structure for arguments of mutually exclusive flag options.
+    struct GetMutualExArgs {
+        std::string_view trueOptName;      // Name of the option that represents the true condition.
+        std::string_view trueDescription;  // Description of the option that represents the true condition.
+        std::string_view falseOptName;     // Name of the option that represents the false condition.
+        std::string_view falseDescription; // Description of the option that represents the false condition.
+        bool             defaultValue;     // Default value if neither option is specified.
+    };
+
+    /**
+     * @brief Checks if two mutually exclusive options exist.
+     * @param args Structure containing the names and descriptions of the mutually exclusive options.
+     * @return True if the first option is present and the second is not, or vice versa;
+               defaultValue if neither option is present.
+     */
+    static bool hasMutualExFlag(const GetMutualExArgs &args) { return hasMutualExFlag_(args, data_); }
+
+    /**
+     * @brief Gets the value of a string option.
+     * @param optName Option names (e.g., "o", "output" or "o,output").
+     * @param description Option description.
+     * @param defaultValue The default value to return if the option is not provided on the command line.
+     * @return A view of the value in argv or the default value.
+     */
+    static std::string_view getString(std::string_view optName, std::string_view description, std::string_view defaultValue = "") {
+        OptionHelpInfo helpInfo{};
+        helpInfo.defaultKind = DefaultKind::String;
+        helpInfo.defaultStr  = defaultValue;
+        auto [found, value]  = getValueStr(optName, description, helpInfo, "string", data_);
+        return found ? value : defaultValue;
+    }
+
+    /**
+     * @brief Gets the value of an integer option.
+     * @param optName Option names (e.g., "n", "count" or "n,count").
+     * @param description Option description.
+     * @param defaultValue The default value.
+     * @return The parsed integer value or the default value.
+     */
+    static long long getInt(std::string_view optName, std::string_view description, long long defaultValue = 0) {
+        OptionHelpInfo helpInfo{};
+        helpInfo.defaultKind   = DefaultKind::Int;
+        helpInfo.defaultInt    = defaultValue;
+        auto [found, valueStr] = getValueStr(optName, description, helpInfo, "integer", data_);
+        if (!found) { return defaultValue; }
+
+        // Values are suffixes of argv elements, so they are null-terminated
+        char *end = nullptr;
+        errno     = 0;
+        auto result = std::strtoll(valueStr.data(), &end, 10);
+        if (end != valueStr.data() && errno != ERANGE) { return result; }
+        appendError(data_, {ErrorKind::InvalidValue, optName, "integer", valueStr});
+        return defaultValue;
+    }
+
+    /**
+     * @brief Gets the value of a floating-point option.
+     * @param optName Option names (e.g., "r", "rate" or "r,rate").
+     * @param description Option description.
+     * @param defaultValue The default value.
+     * @return The parsed floating-point value or the default value.
+     */
+    static double getDouble(std::string_view optName, std::string_view description, double defaultValue = 0.0) {
+        OptionHelpInfo helpInfo{};
+        helpInfo.defaultKind   = DefaultKind::Double;
+        helpInfo.defaultDouble = defaultValue;
+        auto [found, valueStr] = getValueStr(optName, description, helpInfo, "float", data_);
+        if (!found) { return defaultValue; }
+
+        char *end = nullptr;
+        errno     = 0;
+        auto result = std::strtod(valueStr.data(), &end);
+        if (end != valueStr.data() && errno != ERANGE) { return result; }
+        appendError(data_, {ErrorKind::InvalidValue, optName, "float", valueStr});
+        return defaultValue;
+    }
+
+    /**
+     * @brief Gets the value of a boolean option.
+     * @details "1", "true", "yes", "on" (case-insensitive) will be parsed as true.
+     *          "0", "false", "no", "off" (case-insensitive) will be parsed as false.
+     *          Other values will cause the program to report an error and exit.
+     * @param optName Option names (e.g., "e", "enable" or "e,enable").
+     * @param description Option description.
+     * @param defaultValue The default value.
+     * @return The parsed boolean value or the default value.
+     */
+    static bool getBool(std::string_view optName, std::string_view description, bool defaultValue = false) {
+        OptionHelpInfo helpInfo{};
+        helpInfo.defaultKind   = DefaultKind::Bool;
+        helpInfo.defaultBool   = defaultValue;
+        auto [found, valueStr] = getValueStr(optName, description, helpInfo, "bool", data_);
+        if (!found) { return defaultValue; }
+
+        for (std::string_view word : {"true", "1", "yes", "on"}) {
+            if (equalsIgnoreCase(valueStr, word)) { return true; }
+        }
+        for (std::string_view word : {"false", "0", "no", "off"}) {
+            if (equalsIgnoreCase(valueStr, word)) { return false; }
+        }
+
+        appendError(data_, {ErrorKind::InvalidValue, optName, "bool", valueStr});
+        return defaultValue;
+    }
+
+    /**
+     * @brief Gets a positional argument.
+     * @details Must be called after all get/hasFlag calls. Should be called in order.
+     * @param posName Argument name, used for the help message (e.g., "input-file").
+     * @param description Argument description.
+     * @param required If true and the user does not provide the argument,
+                       the program will report an error and exit.
+     * @param defaultValue The default value to return if the argument
+                            is not provided and not required.
+     * @return A view of the argument in argv, or the default value if it is not provided.
+     */
+    static std::string_view getPositional(
+        std::string_view posName, std::string_view description,
+        bool required = true, std::string_view defaultValue = "") {
+        return getPositional_(posName, description, required, defaultValue, data_);
+    }
+
+    /**
+     * @brief Gets all remaining positional arguments.
+     * @details Must be called after all getPositional calls.
+     * @param posName Argument name, used for the help message (e.g., "extra-files").
+     * @param description Argument description.
+     * @param required If true and there are no remaining arguments,
+                       the program will report an error and exit.
+     * @param defaultValue The default values to return if the argument
+                            is not provided and not required, e.g., a `static constexpr std::string_view[]` array.
+     * @return A list viewing all remaining arguments.
+     */
+    static ArgList getRemainingPositionals(
+        std::string_view posName, std::string_view description,
+        bool required = true, ArgList defaultValue = {}) {
+        return getRemainingPositionals_(posName, description, required, defaultValue, data_);
+    }
+
+    /**
+     * @brief Inserts a custom option header in the help message.
+     * @details See the README for details.
+     * @param header The option header text.
+     */
+    static void insertOptHeader(std::string_view header) {
+        data_.hasCustumOptHeader = true;
+        OptionHelpInfo helpInfo{};
+        helpInfo.longOpt     = header;
+        helpInfo.isOptHeader = true;
+        pushOptionHelp(data_, helpInfo);
+    }
+
+    /**
+     * @brief Set the help footer text.
+     * @details See the README for details.
+     * @param footer The help footer text.
+     */
+    static void setHelpFooter(std::string_view footer) { data_.helpFooter = footer; }
+
+    /**
+     * @brief Changes the description indent of option descriptions in the help message. Default is 25.
+     * @details This function should be called before tryToPrintHelp.
+     * @param indent The new description indent.
+     */
+    static void changeDescriptionIndent(size_t indent) { descriptionIndent_ = indent; }
+
+    /**
+     * @brief If the user provides -h or --help, prints the help message and exits the program normally.
+     * @details Recommended to be called after all get/hasFlag calls, and before tryToPrintInvalidOpts.
+     */
+    static void tryToPrintHelp() { tryToPrintHelp_(data_); }
+
+    /**
+     * @brief Checks and reports all unknown options that were not processed by get/hasFlag.
+     * @details If unknown options exist, prints an error message and exits the program abnormally.
+     *          This function should be called after all argument retrieval function calls.
+     * @param notExit If true, the program will not exit after printing any invalid options. Default is false.
+     * @return Returns true if there are any unknown options and notExit is false, false otherwise.
+     */
+    static bool tryToPrintInvalidOpts(bool notExit = false) { return tryToPrintInvalidOpts_(data_, notExit); }
+
+    /**
+     * @brief Finalizes the parser. This function should be called at the end of parsing.
+     * @details This function will print error messages and exit the program if there are any and notExit is true.
+     * @param notExit If true, the program will not exit after printing any error messages. Default is false.
+     * @return Returns true if there are any error messages and notExit is false, false otherwise.
+     */
+    static bool finalize(bool notExit = false) { return finalize_(data_, notExit); }
+
+    /**
+     * @brief Runs tryToPrintHelp, tryToPrintInvalidOpts, and finalize in sequence.
+     * @param notExit If true, the program will not exit after printing any invalid options
+                      or any error messages. Default is false.
+     * @return Returns true if there are any invalid options or any error messages and notExit is false,
+               false otherwise.
+     */
+    static bool runAllPostprocess(bool notExit = false) {
+        tryToPrintHelp_(data_);
+        auto hasInvalidOpts = tryToPrintInvalidOpts_(data_, true);
+        auto hasError       = finalize_(data_, true);
+
+        if (!notExit && (hasInvalidOpts || hasError)) {
+            std::exit(EXIT_FAILURE);
+        }
+        return hasInvalidOpts || hasError;
+    }
+
+    FixedParser() = delete;
+
+private:
+    // An option on the command line, the value is a slice of argv[argvIndex].
+    // index > 0: Index of the argument in argv;
+    // index < 0: Index of the flag option in argv;
+    // index == 0: Default value, no special meaning yet.
+    // valueOffset > 0 means the value is inside the option argument (-n123 and --opt=val forms).
+    struct OptionInfo {
+        std::string_view key; // Option name (e.g., "-o", "--output")
+        int              argvIndex;
+        std::uint32_t    valueOffset;
+        bool             isRemoved; // Processed by get/hasFlag
+    };
+
+    enum class DefaultKind : unsigned char { None, String, Int, Double, Bool };
+
+    struct OptionHelpInfo {
+        char             shortOpt; // Without "-", '\0' if there is no short option
+        std::string_view longOpt;  // Without "--", the header text if it is an option header
+        std::string_view description;
+        std::string_view typeName;
+        DefaultKind      defaultKind;
+        std::string_view defaultStr;
+        long long        defaultInt;
+        double           defaultDouble;
+        bool             defaultBool;
+        bool             isMutualExDefault;
+        bool             isOptHeader;
+
+        // Numbers are formatted here, so get functions do not need a buffer for them
+        template <typename Out>
+        void printDefault(Out &out) const {
+            std::array<char, 32> buf{};
+            std::string_view     defaultValue;
+            switch (defaultKind) {
+            case DefaultKind::None: break;
+            case DefaultKind::String: defaultValue = defaultStr; break;
+            case DefaultKind::Bool: defaultValue = defaultBool ? "true" : "false"; break;
+            case DefaultKind::Int: {
+                int len      = std::snprintf(buf.data(), buf.size(), "%lld", defaultInt);
+                defaultValue = std::string_view(buf.data(), static_cast<size_t>(std::max(len, 0)));
+                break;
+            }
+            case DefaultKind::Double: {
+                int  len = std::snprintf(buf.data(), buf.size() - 2, "%g", defaultDouble);
+                auto pos = static_cast<size_t>(std::max(len, 0));
+                // Keep it looking like a float, e.g., "3.0" instead of "3"
+                if (std::string_view(buf.data(), pos).find_first_of(".en") == std::string_view::npos) {
+                    buf[pos++] = '.';
+                    buf[pos++] = '0';
+                }
+                defaultValue = std::string_view(buf.data(), pos);
+                break;
+            }
+            }
+            if (!defaultValue.empty()) { out << " [default: " << defaultValue << ']'; }
+        }
+    };
+
+    struct PositionalHelpInfo {
+        std::string_view name;
+        std::string_view description;
+        std::string_view defaultValue;
+        ArgList          defaultValues; // Only used for remaining positionals
+        bool             isRequired;
+        bool             isRemaining;
+
+        template <typename Out>
+        void printDefault(Out &out) const {
+            if (!defaultValue.empty()) {
+                out << " [default: " << defaultValue << ']';
+            }
+            if (!defaultValues.empty()) {
+                out << " [default: [\"";
+                for (size_t j = 0; j < defaultValues.size(); j++) {
+                    if (j != 0) { out << "\", \""; }
+                    out << defaultValues[j];
+                }
+                out << "\"]]";
+            }
+        }
+    };
+
+    enum class ErrorKind : unsigned char { InvalidValue, MissingValue, MissingPositional, MissingRemaining };
+
+    // Error messages are rendered when they are printed
+    struct ErrorInfo {
+        ErrorKind        kind;
+        std::string_view name; // Option names (e.g., "o,out") or the positional name
+        std::string_view typeName;
+        std::string_view value;
+    };
+
+    // -V and -h are added when the help message is printed
+    static constexpr size_t MAX_OPTION_HELP_ENTRIES = MaxOpts + 2;
+    static constexpr size_t MAX_ERRORS              = MaxOpts + MaxPositionals;
+
+    struct InternalData {
+        std::string_view programName;
+        std::string_view programDescription;
+        std::string_view shortNonFlagOptsStr;
+        std::string_view helpFooter;
+        size_t           positionalIdx;
+        bool             hasCustumOptHeader;
+        bool             hasTooManyArgs;
+        bool             hasTooManyOpts;
+        // Containers
+        std::array<OptionInfo, MaxArgc>                         options;     // In command-line order
+        std::array<size_t, MaxArgc>                             optionOrder; // Indices into options, sorted by key
+        std::array<OptionHelpInfo, MAX_OPTION_HELP_ENTRIES>     optionHelpEntries;
+        std::array<int, MaxArgc>                                positionalArgsIndices;
+        std::array<PositionalHelpInfo, MaxPositionals>          positionalHelpEntries;
+        std::array<ErrorInfo, MAX_ERRORS>                       errors;
+        size_t                                                  optionCount;
+        size_t                                                  optionHelpCount;
+        size_t                                                  positionalCount;
+        size_t                                                  positionalHelpCount;
+        size_t                                                  errorCount;
+    };
+
+    // Buffers the output on the stack and writes it to the sink when it is full
+    class Writer {
+    public:
+        explicit Writer(const OutputSink &sink) : sink_(sink) {}
+        Writer(const Writer &)            = delete;
+        Writer &operator=(const Writer &) = delete;
+        ~Writer() { flush(); }
+
+        Writer &operator<<(std::string_view sv) {
+            while (!sv.empty()) {
+                size_t len = std::min(sv.size(), buf_.size() - size_);
+                std::memcpy(buf_.data() + size_, sv.data(), len);
+                size_ += len;
+                sv.remove_prefix(len);
+                if (size_ == buf_.size()) { flush(); }
+            }
+            return *this;
+        }
+
+        Writer &operator<<(char ch) { return *this << std::string_view(&ch, 1); }
+
+        Writer &operator<<(const Formatter::Styled &styled) {
+            styled.forEachPart([this](std::string_view part) { *this << part; });
+            return *this;
+        }
+
+        Formatter::Styled styled(std::string_view sv, Formatter::Style style) const { return Formatter::styled(sv, style, sink_); }
+
+        void pad(size_t count) {
+            for (size_t i = 0; i < count; i++) { *this << ' '; }
+        }
+
+        void flush() {
+            if (size_ == 0) { return; }
+            sink_.write(std::string_view(buf_.data(), size_));
+            size_ = 0;
+        }
+
+    private:
+        static constexpr size_t BUFFER_SIZE = 1024;
+
+        const OutputSink               &sink_;
+        std::array<char, BUFFER_SIZE> buf_{};
+        size_t                         size_ = 0;
+    };
+
+    // Internal data storage
+    static inline int                argc_;
+    static inline const char *const *argv_;
+
+    static inline size_t           descriptionIndent_ = 25; // NOLINT(readability-magic-numbers)
+    static inline OutputSink       outSink_           = OutputSink::fd(1);
+    static inline OutputSink       errSink_           = OutputSink::fd(2);
+    static inline std::string_view programVersion_;
+    static inline InternalData     data_;
+
+    // === Preprocess ===
+
+    static void preprocess_(int argc, const char *const *argv) {
+        auto &data = data_;
+
+        // Arguments beyond the capacity are ignored
+        if (static_cast<size_t>(argc) > MaxArgc) {
+            data.hasTooManyArgs = true;
+            argc                = static_cast<int>(MaxArgc);
+        }
+        argc_ = argc;
+        argv_ = argv;
+
+        if (argc_ > 0) { data.programName = MinimalCommon::baseName(argv[0]); }
+
+        struct Store {
+            InternalData &data;
+
+            void pushPositional(int argvIndex) { pushPositionalIndex(data, argvIndex); }
+            void setOption(std::string_view key, int argvIndex, size_t valueOffset) {
+                FixedParser::setOption(data, key, argvIndex, static_cast<std::uint32_t>(valueOffset));
+            }
+            // Values in the option argument are not positional
+            int consumedIndex(std::string_view key) const {
+                const auto *optInfo = findOptionInfo(data, {}, key);
+                return optInfo != nullptr && optInfo->valueOffset == 0 ? optInfo->argvIndex : 0;
+            }
+        } store{data};
+        MinimalCommon::scanArgs(argc, argv, data.shortNonFlagOptsStr, store);
+    }
+
+    // Compares an option key with the key made of prefix and name, without building it
+    static int compareKey(std::string_view key, std::string_view prefix, std::string_view name) {
+        auto head = key.substr(0, prefix.size());
+        if (int result = head.compare(prefix); result != 0) { return result; }
+        return key.substr(head.size()).compare(name);
+    }
+
+    // Binary searches the sorted index, returns the position of the key or where it should be inserted
+    static size_t findOptionOrder(const InternalData &data, std::string_view prefix, std::string_view name) {
+        const auto *first = data.optionOrder.data();
+        const auto *pos   = std::lower_bound(first, first + data.optionCount, 0, [&](size_t idx, int) {
+            return compareKey(data.options[idx].key, prefix, name) < 0;
+        });
+        return static_cast<size_t>(pos - first);
+    }
+
+    // Finds the option by its key, e.g., ("--", "output") or ({}, "-o")
+    static OptionInfo *findOptionInfo(InternalData &data, std::string_view prefix, std::string_view name) {
+        size_t pos = findOptionOrder(data, prefix, name);
+        if (pos == data.optionCount) { return nullptr; }
+        auto &optInfo = data.options[data.optionOrder[pos]];
+        return compareKey(optInfo.key, prefix, name) == 0 ? &optInfo : nullptr;
+    }
+
+    // Adds or updates the option, the last occurrence wins
+    static void setOption(InternalData &data, std::string_view key, int argvIndex, std::uint32_t valueOffset = 0) {
+        size_t pos = findOptionOrder(data, {}, key);
+        if (pos != data.optionCount && data.options[data.optionOrder[pos]].key == key) {
+            auto &optInfo       = data.options[data.optionOrder[pos]];
+            optInfo.argvIndex   = argvIndex;
+            optInfo.valueOffset = valueOffset;
+            return;
+        }
+        // Bundled short options can fill the slots even if argc is within the limit
+        if (data.optionCount == data.options.size()) {
+            data.hasTooManyOpts = true;
+            return;
+        }
+        auto *order = data.optionOrder.data();
+        std::copy_backward(order + pos, order + data.optionCount, order + data.optionCount + 1);
+        order[pos]                       = data.optionCount;
+        data.options[data.optionCount++] = {key, argvIndex, valueOffset, false};
+    }
+
+    static void pushPositionalIndex(InternalData &data, int argvIndex) {
+        if (data.positionalCount < data.positionalArgsIndices.size()) {
+            data.positionalArgsIndices[data.positionalCount++] = argvIndex;
+        }
+    }
+
+    // === Get functions ===
+
+    static bool hasFlag_(std::string_view optName, std::string_view description, InternalData &data) {
+        OptionHelpInfo helpInfo{};
+        helpInfo.description = description;
+        parseOptName(optName, helpInfo);
+        pushOptionHelp(data, helpInfo);
+
+        const auto *optInfo = findOption(helpInfo, data);
+        // A flag was passed with a value, e.g., -f 123. The value is likely a positional arg.
+        if (optInfo != nullptr && optInfo->argvIndex > 0 && optInfo->valueOffset == 0) {
+            pushPositionalIndex(data, optInfo->argvIndex);
+        }
+
+        return optInfo != nullptr;
+    }
+
+    static bool hasMutualExFlag_(const GetMutualExArgs &args, InternalData &data) {
+        OptionHelpInfo trueHelpInfo{};
+        trueHelpInfo.description       = args.trueDescription;
+        trueHelpInfo.isMutualExDefault = args.defaultValue;
+        parseOptName(args.trueOptName, trueHelpInfo);
+        pushOptionHelp(data, trueHelpInfo);
+
+        OptionHelpInfo falseHelpInfo{};
+        falseHelpInfo.description       = args.falseDescription;
+        falseHelpInfo.isMutualExDefault = !args.defaultValue;
+        parseOptName(args.falseOptName, falseHelpInfo);
+        pushOptionHelp(data, falseHelpInfo);
+
+        const auto *trueInfo  = findOption(trueHelpInfo, data);
+        const auto *falseInfo = findOption(falseHelpInfo, data);
+
+        for (const auto *optInfo : {trueInfo, falseInfo}) {
+            if (optInfo != nullptr && optInfo->argvIndex > 0 && optInfo->valueOffset == 0) {
+                pushPositionalIndex(data, optInfo->argvIndex);
+            }
+        }
+
+        if (trueInfo == nullptr && falseInfo == nullptr) { return args.defaultValue; }
+
+        // They are negative, so Smaller is latter
+        if (trueInfo != nullptr && falseInfo != nullptr) {
+            return trueInfo->argvIndex < falseInfo->argvIndex;
+        }
+
+        return trueInfo != nullptr;
+    }
+
+    static std::string_view getPositional_(
+        std::string_view posName, std::string_view description, bool isRequired,
+        std::string_view defaultValue, InternalData &data) {
+
+        fixPositionalArgsArray(data);
+
+        PositionalHelpInfo helpInfo{};
+        helpInfo.name         = posName;
+        helpInfo.description  = description;
+        helpInfo.defaultValue = defaultValue;
+        helpInfo.isRequired   = isRequired;
+        pushPositionalHelp(data, helpInfo);
+
+        if (data.positionalIdx < data.positionalCount) {
+            int argvIdx = data.positionalArgsIndices[data.positionalIdx];
+            data.positionalIdx++;
+            return argv_[argvIdx];
+        }
+
+        if (isRequired) {
+            appendError(data, {ErrorKind::MissingPositional, posName, {}, {}});
+        }
+        return defaultValue;
+    }
+
+    static ArgList getRemainingPositionals_(
+        std::string_view posName, std::string_view description, bool required,
+        ArgList defaultValue, InternalData &data) {
+
+        fixPositionalArgsArray(data);
+
+        PositionalHelpInfo helpInfo{};
+        helpInfo.name          = posName;
+        helpInfo.description   = description;
+        helpInfo.defaultValues = defaultValue;
+        helpInfo.isRequired    = required;
+        helpInfo.isRemaining   = true;
+        pushPositionalHelp(data, helpInfo);
+
+        ArgList remaining;
+        remaining.argv_    = argv_;
+        remaining.indices_ = data.positionalArgsIndices.data() + data.positionalIdx;
+        remaining.size_    = data.positionalCount - std::min(data.positionalIdx, data.positionalCount);
+        data.positionalIdx = data.positionalCount;
+
+        if (remaining.empty()) {
+            if (required) {
+                appendError(data, {ErrorKind::MissingRemaining, posName, {}, {}});
+            } else {
+                return defaultValue;
+            }
+        }
+        return remaining;
+    }
+
+    // === Helper functions for get functions ===
+
+    // Parses option names (e.g., "o,out") into the help entry
+    static void parseOptName(std::string_view optName, OptionHelpInfo &helpInfo) {
+        if (optName.empty()) {
+            errSink_.write("[ArgLite] Error: Option name in hasFlag/get* functions cannot be empty.\n");
+            std::exit(EXIT_FAILURE);
+        }
+        auto names        = MinimalCommon::splitOptName(optName);
+        helpInfo.shortOpt = names.shortOpt;
+        helpInfo.longOpt  = names.longOpt;
+    }
+
+    // Finds the later one of the short and long options and removes both
+    static const OptionInfo *findOption(const OptionHelpInfo &helpInfo, InternalData &data) {
+        OptionInfo *shortInfo = nullptr;
+        OptionInfo *longInfo  = nullptr;
+        if (helpInfo.shortOpt != '\0') { shortInfo = findOptionInfo(data, {}, MinimalCommon::shortOptKey(helpInfo.shortOpt)); }
+        if (!helpInfo.longOpt.empty()) { longInfo = findOptionInfo(data, "--", helpInfo.longOpt); }
+
+        OptionInfo *found = nullptr;
+        for (auto *optInfo : {shortInfo, longInfo}) {
+            if (optInfo == nullptr || optInfo->isRemoved) { continue; }
+            optInfo->isRemoved = true;
+            if (found == nullptr || std::abs(optInfo->argvIndex) > std::abs(found->argvIndex)) {
+                found = optInfo;
+            }
+        }
+        return found;
+    }
+
+    // Uses the option name to get a value from the options array.
+    static std::pair<bool, std::string_view> getValueStr(
+        std::string_view optName, std::string_view description, OptionHelpInfo &helpInfo,
+        std::string_view typeName, InternalData &data) {
+
+        helpInfo.description = description;
+        helpInfo.typeName    = typeName;
+        parseOptName(optName, helpInfo);
+        pushOptionHelp(data, helpInfo);
+
+        const auto *optInfo = findOption(helpInfo, data);
+        if (optInfo == nullptr) { return {false, {}}; }
+
+        if (optInfo->argvIndex < 0) { // It's treated as a flag, indicating that it has no value
+            appendError(data, {ErrorKind::MissingValue, optName, {}, {}});
+            return {false, {}};
+        }
+        return {true, argv_[optInfo->argvIndex] + optInfo->valueOffset};
+    }
+
+    static void fixPositionalArgsArray(InternalData &data) {
+        for (size_t i = 0; i < data.optionCount; i++) {
+            auto &optInfo = data.options[i];
+            // Unrecognized option that consumed a positional arg, values in the option arg are not positional
+            if (!optInfo.isRemoved && optInfo.argvIndex > 0 && optInfo.valueOffset == 0) {
+                pushPositionalIndex(data, optInfo.argvIndex);
+                optInfo.argvIndex = 0;
+            }
+        }
+
+        // Keep positional args sorted by their original index to maintain order
+        std::sort(data.positionalArgsIndices.begin(), data.positionalArgsIndices.begin() + data.positionalCount);
+    }
+
+    static bool equalsIgnoreCase(std::string_view sv, std::string_view lowerWord) {
+        return sv.size() == lowerWord.size() &&
+               std::equal(sv.begin(), sv.end(), lowerWord.begin(), [](char a, char b) {
+                   return (a >= 'A' && a <= 'Z' ? static_cast<char>(a - 'A' + 'a') : a) == b;
+               });
+    }
+
+    static void pushOptionHelp(InternalData &data, const OptionHelpInfo &helpInfo) {
+        if (data.optionHelpCount == data.optionHelpEntries.size()) {
+            errSink_.write("[ArgLite] Error: Too many options, increase MaxOpts of FixedParser.\n");
+            std::exit(EXIT_FAILURE);
+        }
+        data.optionHelpEntries[data.optionHelpCount++] = helpInfo;
+    }
+
+    static void pushPositionalHelp(InternalData &data, const PositionalHelpInfo &helpInfo) {
+        if (data.positionalHelpCount == data.positionalHelpEntries.size()) {
+            errSink_.write("[ArgLite] Error: Too many positional arguments, increase MaxPositionals of FixedParser.\n");
+            std::exit(EXIT_FAILURE);
+        }
+        data.positionalHelpEntries[data.positionalHelpCount++] = helpInfo;
+    }
+
+    static void appendError(InternalData &data, const ErrorInfo &error) {
+        // Each get call appends one error at most, so it always fits
+        if (data.errorCount < data.errors.size()) { data.errors[data.errorCount++] = error; }
+    }
+
+    // === Post-process ===
+
+    static void tryToPrintVersion_(InternalData &data) {
+        if (programVersion_.empty()) { return; }
+        OptionHelpInfo helpInfo{};
+        helpInfo.shortOpt    = 'V';
+        helpInfo.longOpt     = "version";
+        helpInfo.description = "Show version information and exit";
+        pushOptionHelp(data, helpInfo);
+        if (findOption(helpInfo, data) != nullptr) {
+            Writer(outSink_) << programVersion_ << '\n';
+            std::exit(EXIT_SUCCESS);
+        }
+    }
+
+    static void tryToPrintHelp_(InternalData &data) {
+        tryToPrintVersion_(data);
+
+        OptionHelpInfo helpInfo{};
+        helpInfo.shortOpt    = 'h';
+        helpInfo.longOpt     = "help";
+        helpInfo.description = "Show this help message and exit";
+        if (findOption(helpInfo, data) != nullptr) {
+            pushOptionHelp(data, helpInfo);
+            printHelp(data);
+            std::exit(EXIT_SUCCESS);
+        }
+    }
+
+    static bool tryToPrintInvalidOpts_(InternalData &data, bool notExit) {
+        // Help options are handled by tryToPrintHelp
+        OptionHelpInfo helpInfo{};
+        helpInfo.shortOpt = 'h';
+        helpInfo.longOpt  = "help";
+        findOption(helpInfo, data);
+
+        bool   hasInvalidOpts = false;
+        Writer out(errSink_);
+        auto   errorStr = Formatter::styled("Error: ", Formatter::Style::Red, errSink_);
+        for (size_t i = 0; i < data.optionCount; i++) {
+            const auto &optInfo = data.options[i];
+            if (optInfo.isRemoved) { continue; }
+            out << errorStr << "Unrecognized option '"
+                << Formatter::styled(optInfo.key, Formatter::Style::Bold, errSink_) << "'\n";
+            hasInvalidOpts = true;
+        }
+        out.flush();
+
+        if (hasInvalidOpts && !notExit) { std::exit(EXIT_FAILURE); }
+        return hasInvalidOpts;
+    }
+
+    static void printHelp(const InternalData &data) {
+        Writer out(outSink_);
+        MinimalCommon::printHelp(
+            out, {data.programDescription, data.programName, data.helpFooter, data.hasCustumOptHeader, descriptionIndent_},
+            MinimalCommon::Span<OptionHelpInfo>{data.optionHelpEntries.data(), data.optionHelpCount},
+            MinimalCommon::Span<PositionalHelpInfo>{data.positionalHelpEntries.data(), data.positionalHelpCount});
+    }
+
+    static void printErrorMessage(Writer &out, const ErrorInfo &error) {
+        auto bold = [](std::string_view sv) { return Formatter::styled(sv, Formatter::Style::Bold, errSink_); };
+
+        switch (error.kind) {
+        case ErrorKind::InvalidValue:
+            out << "Invalid value for option '";
+            printOptName(out, error.name);
+            out << "'. Expected a " << bold(error.typeName) << ", but got '"
+                << Formatter::styled(error.value, Formatter::Style::Yellow, errSink_) << "'.";
+            break;
+        case ErrorKind::MissingValue:
+            out << "Option '";
+            printOptName(out, error.name);
+            out << "' requires a value.";
+            break;
+        case ErrorKind::MissingPositional:
+            out << "Missing required positional argument '" << bold(error.name) << "'.";
+            break;
+        case ErrorKind::MissingRemaining:
+            out << "Missing required positional argument(s) '" << bold(error.name) << "'.";
+            break;
+        }
+    }
+
+    // Prints option names (e.g., "o,out") as "-o, --out" in bold
+    static void printOptName(Writer &out, std::string_view optName) {
+        auto bold = [](std::string_view sv) { return Formatter::styled(sv, Formatter::Style::Bold, errSink_); };
+
+        OptionHelpInfo helpInfo{};
+        parseOptName(optName, helpInfo);
+        if (helpInfo.shortOpt != '\0') {
+            out << bold(MinimalCommon::shortOptKey(helpInfo.shortOpt));
+            if (!helpInfo.longOpt.empty()) { out << bold(", "); }
+        }
+        if (!helpInfo.longOpt.empty()) { out << bold("--") << bold(helpInfo.longOpt); }
+    }
+
+    // Clear internal data, the arrays are reused
+    static void clearData(InternalData &data) {
+        data.programName         = {};
+        data.programDescription  = {};
+        data.shortNonFlagOptsStr = {};
+        data.positionalIdx       = 0;
+        data.hasCustumOptHeader  = false;
+        data.hasTooManyArgs      = false;
+        data.hasTooManyOpts      = false;
+        data.optionCount         = 0;
+        data.optionHelpCount     = 0;
+        data.positionalCount     = 0;
+        data.positionalHelpCount = 0;
+        data.errorCount          = 0;
+    }
+
+    static bool finalize_(InternalData &data, bool notExit) {
+        if (data.errorCount == 0 && !data.hasTooManyArgs && !data.hasTooManyOpts) {
+            clearData(data);
+            return false;
+        }
+
+        {
+            Writer out(errSink_);
+            out << "Errors occurred while parsing command-line arguments.\n";
+            out << "The following is a list of error messages:\n";
+            auto errorStr = Formatter::styled("Error: ", Formatter::Style::Red, errSink_);
+            if (data.hasTooManyArgs) {
+                std::array<char, 32> buf{};
+                int                  len = std::snprintf(buf.data(), buf.size(), "%zu", MaxArgc);
+                out << errorStr << "Too many arguments, only the first "
+                    << std::string_view(buf.data(), static_cast<size_t>(std::max(len, 0))) << " are parsed.\n";
+            }
+            if (data.hasTooManyOpts) {
+                out << errorStr << "Too many options, the rest are ignored. Increase MaxArgc of FixedParser.\n";
+            }
+            for (size_t i = 0; i < data.errorCount; i++) {
+                out << errorStr;
+                printErrorMessage(out, data.errors[i]);
+                out << '\n';
+            }
+        }
+
+        if (notExit) {
+            clearData(data);
+            return true;
+        }
+        std::exit(EXIT_FAILURE);
+    }
+}; // class FixedParser
+
+} // namespace ArgLite
@@ -12,10 +12,7 @@ namespace ArgLite {
 inline bool Parser::hasFlag_(
     std::string_view optName, const std::string &description, InternalData &data) {
 
-    auto [shortOpt, longOpt] = parseOptNameAsPair(optName);
-    data.optionHelpEntries.push_back({shortOpt, longOpt, description, ""});
-
-    auto optNode = findOption(shortOpt, longOpt, data);
+    auto optNode = findOption(pushOptionHelp(data, optName, description), data);
 
     if (!optNode.empty()) {
         const auto &optInfo = optNode.mapped();
@@ -29,14 +26,13 @@ inline bool Parser::hasFlag_(
 }
 
 bool Parser::hasMutualExFlag_(const GetMutualExArgs &args, InternalData &data) {
-    auto [shortTrueOpt, longTrueOpt]   = parseOptNameAsPair(args.trueOptName);
-    auto [shortFalseOpt, longFalseOpt] = parseOptNameAsPair(args.falseOptName);
-
-    data.optionHelpEntries.push_back({shortTrueOpt, longTrueOpt, args.trueDescription, "", "", args.defaultValue});
-    data.optionHelpEntries.push_back({shortFalseOpt, longFalseOpt, args.falseDescription, "", "", !args.defaultValue});
+    auto &trueHelpInfo             = pushOptionHelp(data, args.trueOptName, args.trueDescription);
+    trueHelpInfo.isMutualExDefault = args.defaultValue;
+    auto trueNode                  = findOption(trueHelpInfo, data);
 
-    auto trueNode  = findOption(shortTrueOpt, longTrueOpt, data);
-    auto falseNode = findOption(shortFalseOpt, longFalseOpt, data);
+    auto &falseHelpInfo             = pushOptionHelp(data, args.falseOptName, args.falseDescription);
+    falseHelpInfo.isMutualExDefault = !args.defaultValue;
+    auto falseNode                  = findOption(falseHelpInfo, data);
 
     if (!trueNode.empty() && trueNode.mapped().argvIndex > 0) {
         data.positionalArgsIndices.push_back(trueNode.mapped().argvIndex);
@@ -179,18 +175,18 @@ inline void Parser::appendOptValErrorMsg(
 
     std::string errorStr;
     errorStr += "Invalid value for option '";
-    errorStr += Formatter::bold(parseOptName(optName), std::cerr);
+    Formatter::styled(parseOptName(optName), Formatter::Style::Bold, std::cerr).appendTo(errorStr);
     errorStr += "'. Expected a ";
-    errorStr += Formatter::bold(typeName, std::cerr);
+    Formatter::styled(typeName, Formatter::Style::Bold, std::cerr).appendTo(errorStr);
     errorStr += ", but got '";
-    errorStr += Formatter::yellow(valueStr, std::cerr);
+    Formatter::styled(valueStr, Formatter::Style::Yellow, std::cerr).appendTo(errorStr);
     errorStr += "'.";
     data.errorMessages.push_back(std::move(errorStr));
 }
 
 inline void Parser::appendPosValErrorMsg(InternalData &data, std::string_view posName, std::string_view errorMsg) {
     std::string msg(errorMsg);
-    msg.append(Formatter::bold(posName));
+    Formatter::styled(posName, Formatter::Style::Bold, std::cerr).appendTo(msg);
     msg.append("'.");
     data.errorMessages.push_back(std::move(msg));
 }
@@ -210,50 +206,34 @@ inline std::string Parser::toString(const T &val) {
 
 // Parses option name (e.g., "o,out") and return a formatted string (e.g., "-o, --out")
 inline std::string Parser::parseOptName(std::string_view optName) {
-    auto [shortOpt, longOpt] = parseOptNameAsPair(optName);
-
-    // Short option only
-    if (longOpt.empty()) { return shortOpt; }
+    auto names = MinimalCommon::splitOptName(optName);
 
-    // Long option only
-    if (shortOpt.empty()) { return longOpt; }
-
-    // Short and long options combined
-    return std::string(shortOpt).append(", ").append(longOpt);
+    std::string result;
+    if (names.shortOpt != '\0') {
+        result.append(MinimalCommon::shortOptKey(names.shortOpt));
+        if (!names.longOpt.empty()) { result.append(", "); }
+    }
+    if (!names.longOpt.empty()) { result.append("--").append(names.longOpt); }
+    return result;
 }
 
-// Parses option name (o,out) and saves the results in shortOpt (-o) and longOpt (--out)
-inline std::pair<std::string, std::string> Parser::parseOptNameAsPair(std::string_view optName) {
+// Parses option names (e.g., "o,out") and adds a help entry for them
+inline Parser::OptionHelpInfo &Parser::pushOptionHelp(InternalData &data, std::string_view optName, const std::string &description) {
     if (optName.empty()) {
         std::cerr << "[ArgLite] Error: Option name in hasFlag/get* functions cannot be empty." << '\n';
         std::exit(EXIT_FAILURE);
     }
 
-    std::string shortOpt;
-    std::string longOpt;
-    // Short option only
-    if (optName.length() == 1) {
-        shortOpt.append("-").append(optName);
-    }
-    // Long option only
-    else if (optName.length() > 1 && optName[1] != ',') {
-        longOpt.append("--").append(optName);
-    }
-    // Short and long options combined
-    else {
-        shortOpt.append("-").append(optName.substr(0, 1));
-        longOpt.append("--").append(optName.substr(2));
-    }
-
-    return {shortOpt, longOpt};
+    auto names = MinimalCommon::splitOptName(optName);
+    return data.optionHelpEntries.emplace_back(OptionHelpInfo{names.shortOpt, std::string(names.longOpt), description});
 }
 
 // Finds the option in the options_ map
-inline Parser::OptMap::node_type Parser::findOption(
-    const std::string &shortOpt, const std::string &longOpt, InternalData &data) {
-
-    auto longNode  = data.options.extract(longOpt);
-    auto shortNode = data.options.extract(shortOpt);
+inline Parser::OptMap::node_type Parser::findOption(const OptionHelpInfo &helpInfo, InternalData &data) {
+    OptMap::node_type longNode;
+    OptMap::node_type shortNode;
+    if (!helpInfo.longOpt.empty()) { longNode = data.options.extract("--" + helpInfo.longOpt); }
+    if (helpInfo.shortOpt != '\0') { shortNode = data.options.extract(std::string(MinimalCommon::shortOptKey(helpInfo.shortOpt))); }
 
     if (!longNode.empty() && !shortNode.empty()) {
         if (std::abs(longNode.mapped().argvIndex) > std::abs(shortNode.mapped().argvIndex)) {
@@ -270,17 +250,18 @@ inline Parser::OptMap::node_type Parser::findOption(
 // Uses the option name to get a value string from the options_ map.
 inline std::pair<bool, std::string> Parser::getValueStr(std::string_view optName, const std::string &description, const std::string &defaultValueStr, const std::string &typeName, InternalData &data) {
 
-    auto [shortOpt, longOpt] = parseOptNameAsPair(optName);
-    data.optionHelpEntries.push_back({shortOpt, longOpt, description, defaultValueStr, typeName});
+    auto &helpInfo        = pushOptionHelp(data, optName, description);
+    helpInfo.defaultValue = defaultValueStr;
+    helpInfo.typeName     = typeName;
 
-    auto optNode = findOption(shortOpt, longOpt, data);
+    auto optNode = findOption(helpInfo, data);
 
     if (!optNode.empty()) {
         const auto &optInfo = optNode.mapped();
 
         if (optInfo.argvIndex < 0) { // It's treated as a flag, indicating that it has no value
             std::string msg("Option '");
-            msg.append(Formatter::bold(parseOptName(optName)));
+            Formatter::styled(parseOptName(optName), Formatter::Style::Bold, std::cerr).appendTo(msg);
             msg.append("' requires a value.");
             data.errorMessages.push_back(std::move(msg));
             return {false, ""};
@@ -0,0 +1,117 @@
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace ArgLite {
+
+/**
+ * @brief Destination of the text printed by the parser, such as help and error messages.
+ * @details Each message is rendered into one buffer first and then written to the sink at once.
+ */
+class OutputSink {
+public:
+    /**
+     * @brief Creates a sink that writes to a file descriptor.
+     * @param fd The file descriptor, e.g., 1 for stdout or 2 for stderr.
+     */
+    static OutputSink fd(int fd) {
+        OutputSink sink;
+        sink.kind_ = Kind::Fd;
+        sink.fd_   = fd;
+        return sink;
+    }
+
+    /**
+     * @brief Creates a sink that appends to a string.
+     * @param str The string to append to. It must outlive the sink.
+     */
+    static OutputSink string(std::string &str) {
+        OutputSink sink;
+        sink.kind_ = Kind::String;
+        sink.str_  = &str;
+        return sink;
+    }
+
+    /**
+     * @brief Creates a sink that copies into a caller-provided buffer.
+     * @details Text that does not fit into the buffer is dropped. The buffer is not null-terminated.
+     * @param buf The buffer to write to.
+     * @param capacity The size of the buffer.
+     * @param size Receives the number of bytes used in the buffer. Its initial value is the start offset.
+     */
+    static OutputSink buffer(char *buf, size_t capacity, size_t *size) {
+        OutputSink sink;
+        sink.kind_     = Kind::Buffer;
+        sink.buf_      = buf;
+        sink.capacity_ = capacity;
+        sink.size_     = size;
+        return sink;
+    }
+
+    /**
+     * @brief Writes the text to the sink.
+     * @param sv The text to write.
+     */
+    void write(std::string_view sv) const {
+        switch (kind_) {
+        case Kind::Fd: writeFd(sv); break;
+        case Kind::String: str_->append(sv); break;
+        case Kind::Buffer: {
+            size_t len = std::min(sv.size(), capacity_ - std::min(*size_, capacity_));
+            if (len > 0) { std::memcpy(buf_ + *size_, sv.data(), len); }
+            *size_ += len;
+            break;
+        }
+        }
+    }
+
+    /**
+     * @brief Gets the file descriptor of the sink.
+     * @return The file descriptor, or -1 if the sink does not write to a file descriptor.
+     */
+    [[nodiscard]]
+    int descriptor() const { return kind_ == Kind::Fd ? fd_ : -1; }
+
+private:
+    enum class Kind { Fd, String, Buffer };
+
+    OutputSink() = default;
+
+    void writeFd(std::string_view sv) const {
+        // Keep the order with text written through stdio (and iostreams synchronized with it)
+        if (fd_ == 1) { std::fflush(stdout); }
+        if (fd_ == 2) { std::fflush(stderr); }
+
+        while (!sv.empty()) {
+#ifdef _WIN32
+            auto written = _write(fd_, sv.data(), static_cast<unsigned>(sv.size()));
+#else
+            auto written = ::write(fd_, sv.data(), sv.size());
+#endif
+            if (written < 0) {
+                if (errno == EINTR) { continue; }
+                return;
+            }
+            sv.remove_prefix(static_cast<size_t>(written));
+        }
+    }
+
+    Kind         kind_{Kind::Fd};
+    int          fd_{1};
+    std::string *str_{nullptr};
+    char        *buf_{nullptr};
+    size_t       capacity_{0};
+    size_t      *size_{nullptr};
+};
+
+} // namespace ArgLite
@@ -0,0 +1,350 @@
+#pragma once
+
+#include "Core.hpp"
+#include "GetTemplate.hpp" // IWYU pragma: keep
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace ArgLite {
+
+/**
+ * @brief An immutable snapshot of the values returned by the get functions, created by `Parser::snapshot()`.
+ * @details The lookup table, the names and the values are stored in one buffer. A snapshot is never
+ *          modified after it is created, so it can be read from many threads without locking.
+ *          Options are looked up by their short or long name without dashes (e.g., `c` or `count`),
+ *          positional arguments by their name. Values are stored as text and converted when read.
+ */
+class ParsedArgs {
+public:
+    ParsedArgs(const ParsedArgs &)            = delete;
+    ParsedArgs &operator=(const ParsedArgs &) = delete;
+
+    /**
+     * @brief Checks if an option or a positional argument was declared with the name.
+     * @param name The option name without dashes, or the positional argument name.
+     * @return True if it was declared, false otherwise.
+     */
+    [[nodiscard]]
+    bool contains(std::string_view name) const { return find(name) != nullptr; }
+
+    /**
+     * @brief Gets the number of times an option or a positional argument was passed.
+     * @details For a remaining positional argument, it is the number of arguments it received.
+     * @param name The option name without dashes, or the positional argument name.
+     * @return The number of times it was passed, 0 if it was not declared.
+     */
+    [[nodiscard]]
+    unsigned count(std::string_view name) const {
+        const auto *entry = find(name);
+        return entry == nullptr ? 0 : entry->count;
+    }
+
+    /**
+     * @brief Gets the value returned by the get function, i.e., the last value or the default value.
+     * @param name The option name without dashes, or the positional argument name.
+     * @param fallback The value returned if there is no value, e.g., for flags.
+     * @return A view of the value, valid as long as the snapshot.
+     */
+    [[nodiscard]]
+    std::string_view getString(std::string_view name, std::string_view fallback = {}) const {
+        const auto *entry = find(name);
+        if (entry == nullptr || entry->valueCount == 0) { return fallback; }
+        return value(entry->firstValue + entry->valueCount - 1);
+    }
+
+    /**
+     * @brief Gets the value returned by the get function, converted to type T.
+     * @tparam T The type to convert to, any type supported by the get functions.
+     * @param name The option name without dashes, or the positional argument name.
+     * @param fallback The value returned if there is no value or it cannot be converted.
+     * @return The converted value.
+     */
+    template <typename T>
+    [[nodiscard]]
+    T get(std::string_view name, T fallback = T{}) const {
+        const auto *entry = find(name);
+        if (entry == nullptr || entry->valueCount == 0) { return fallback; }
+
+        T result{};
+        if (!Parser::convertType(value(entry->firstValue + entry->valueCount - 1), result)) { return fallback; }
+        return result;
+    }
+
+    /**
+     * @brief Gets all values returned by `getVec()` or `getRemainingPositionals()`, converted to type T.
+     * @tparam T The type to convert to, any type supported by the get functions.
+     * @param name The option name without dashes, or the positional argument name.
+     * @return The converted values, values that cannot be converted are skipped.
+     */
+    template <typename T>
+    [[nodiscard]]
+    std::vector<T> getVec(std::string_view name) const {
+        const auto *entry = find(name);
+        if (entry == nullptr) { return {}; }
+
+        std::vector<T> result;
+        result.reserve(entry->valueCount);
+        for (std::uint32_t i = 0; i < entry->valueCount; i++) {
+            T converted{};
+            if (Parser::convertType(value(entry->firstValue + i), converted)) { result.push_back(std::move(converted)); }
+        }
+        return result;
+    }
+
+    // === Binary Image ===
+
+    // Bumped whenever the layout of the image changes
+    static constexpr std::uint32_t IMAGE_VERSION = 2;
+
+    /**
+     * @brief Gets the size of the binary image written by `serialize()`.
+     */
+    [[nodiscard]]
+    size_t imageSize() const { return sizeof(ImageHeader) + tableSize(entryCount_, valueCount_) + textSize_; }
+
+    /**
+     * @brief Writes the snapshot as a position-independent binary image, e.g., into a shared mapping or a memfd.
+     * @details The image is a header followed by the lookup table, the value slices and the text,
+     *          all addressed by offsets. It can be attached by a process running the same build with `attach()`.
+     * @param dest The destination, it should be aligned to 4 bytes so the image can be attached in place.
+     * @param size The size of the destination.
+     * @return The number of bytes written, or 0 if the destination is too small.
+     */
+    size_t serialize(void *dest, size_t size) const {
+        if (size < imageSize()) { return 0; }
+
+        ImageHeader header{IMAGE_MAGIC, IMAGE_VERSION, sizeof(Entry), sizeof(Slice), static_cast<std::uint32_t>(entryCount_),
+                           static_cast<std::uint32_t>(valueCount_), static_cast<std::uint32_t>(textSize_)};
+        auto       *out = static_cast<char *>(dest);
+        std::memcpy(out, &header, sizeof(header));
+        out += sizeof(header);
+        std::memcpy(out, entries_, entryCount_ * sizeof(Entry));
+        out += entryCount_ * sizeof(Entry);
+        std::memcpy(out, values_, valueCount_ * sizeof(Slice));
+        out += valueCount_ * sizeof(Slice);
+        std::memcpy(out, text_, textSize_);
+        return imageSize();
+    }
+
+    /**
+     * @brief Uses a binary image written by `serialize()` in place, nothing is parsed or copied.
+     * @details The image may be shared with other processes, so every slice in the table is checked
+     *          against the text and the values once, in one pass over the table. The snapshot views the image,
+     *          which must outlive it and must not be modified while it is attached.
+     * @param image The image, aligned to 4 bytes.
+     * @param size The size of the image.
+     * @return The snapshot, or null if the image is truncated, misaligned, corrupt, or has another layout.
+     */
+    [[nodiscard]]
+    static std::shared_ptr<const ParsedArgs> attach(const void *image, size_t size) {
+        if (image == nullptr || size < sizeof(ImageHeader) ||
+            reinterpret_cast<std::uintptr_t>(image) % alignof(Entry) != 0) { return nullptr; }
+
+        ImageHeader header{};
+        std::memcpy(&header, image, sizeof(header));
+        if (header.magic != IMAGE_MAGIC || header.version != IMAGE_VERSION ||
+            header.entrySize != sizeof(Entry) || header.sliceSize != sizeof(Slice)) { return nullptr; }
+
+        // Computed in 64 bits, the counts come from the image and may be anything
+        auto imageSize = sizeof(ImageHeader) + (std::uint64_t{header.entryCount} * sizeof(Entry)) +
+                         (std::uint64_t{header.valueCount} * sizeof(Slice)) + header.textSize;
+        if (size < imageSize) { return nullptr; }
+
+        const auto *table = static_cast<const char *>(image) + sizeof(ImageHeader);
+        std::shared_ptr<const ParsedArgs> args(new ParsedArgs(nullptr, table, header.entryCount, header.valueCount, header.textSize));
+        return args->isValid() ? args : nullptr;
+    }
+
+private:
+    friend class Parser;
+
+    // Sorted by name for binary search, an option with both names has two entries
+    // Fixed-width fields only, the image is shared between processes
+    struct Entry {
+        std::uint32_t nameOffset;
+        std::uint32_t nameSize;
+        std::uint32_t count;
+        std::uint32_t firstValue;
+        std::uint32_t valueCount;
+    };
+
+    struct Slice {
+        std::uint32_t offset;
+        std::uint32_t size;
+    };
+
+    // "ALPA" on a little-endian host, an image from a host with another byte order is rejected
+    static constexpr std::uint32_t IMAGE_MAGIC = 0x41504C41;
+
+    struct ImageHeader {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t entrySize; // sizeof(Entry) and sizeof(Slice) of the writer
+        std::uint32_t sliceSize;
+        std::uint32_t entryCount;
+        std::uint32_t valueCount;
+        std::uint32_t textSize;
+    };
+
+    static size_t tableSize(size_t entryCount, size_t valueCount) {
+        return (entryCount * sizeof(Entry)) + (valueCount * sizeof(Slice));
+    }
+
+    // Lays out the entries, the value slices and the text in one buffer
+    ParsedArgs(size_t entryCount, size_t valueCount, size_t textSize)
+        : ParsedArgs(new char[tableSize(entryCount, valueCount) + textSize], nullptr, entryCount, valueCount, textSize) {}
+
+    // Owns the buffer if it is not null, otherwise views the table of an image
+    ParsedArgs(char *buffer, const char *image, size_t entryCount, size_t valueCount, size_t textSize)
+        : buffer_(buffer),
+          entries_(reinterpret_cast<const Entry *>(buffer != nullptr ? buffer : image)),
+          entryCount_(entryCount),
+          values_(reinterpret_cast<const Slice *>(reinterpret_cast<const char *>(entries_) + (entryCount * sizeof(Entry)))),
+          valueCount_(valueCount),
+          text_(reinterpret_cast<const char *>(entries_) + tableSize(entryCount, valueCount)),
+          textSize_(textSize) {}
+
+    // Only used to fill an owned buffer
+    Entry *mutableEntries() { return reinterpret_cast<Entry *>(buffer_.get()); }
+    Slice *mutableValues() { return reinterpret_cast<Slice *>(buffer_.get() + (entryCount_ * sizeof(Entry))); }
+    char  *mutableText() { return buffer_.get() + tableSize(entryCount_, valueCount_); }
+
+    // Checks that every slice of an attached image stays inside the text and the values,
+    // and that the entries are sorted for the binary search
+    [[nodiscard]]
+    bool isValid() const {
+        auto inText = [this](std::uint32_t offset, std::uint32_t size) {
+            return std::uint64_t{offset} + size <= textSize_;
+        };
+        for (size_t i = 0; i < valueCount_; i++) {
+            if (!inText(values_[i].offset, values_[i].size)) { return false; }
+        }
+        for (size_t i = 0; i < entryCount_; i++) {
+            const auto &entry = entries_[i];
+            if (!inText(entry.nameOffset, entry.nameSize) ||
+                std::uint64_t{entry.firstValue} + entry.valueCount > valueCount_) { return false; }
+            if (i > 0 && name(entry) < name(entries_[i - 1])) { return false; }
+        }
+        return true;
+    }
+
+    [[nodiscard]]
+    std::string_view name(const Entry &entry) const { return {text_ + entry.nameOffset, entry.nameSize}; }
+
+    [[nodiscard]]
+    std::string_view value(std::uint32_t index) const { return {text_ + values_[index].offset, values_[index].size}; }
+
+    [[nodiscard]]
+    const Entry *find(std::string_view key) const {
+        const Entry *begin = entries_;
+        const Entry *end   = entries_ + entryCount_;
+        const Entry *it    = std::lower_bound(begin, end, key, [this](const Entry &entry, std::string_view k) {
+            return name(entry) < k;
+        });
+        return it != end && name(*it) == key ? it : nullptr;
+    }
+
+    std::unique_ptr<char[]> buffer_;
+    const Entry            *entries_;
+    size_t                  entryCount_;
+    const Slice            *values_;
+    size_t                  valueCount_;
+    const char             *text_;
+    size_t                  textSize_;
+};
+
+// === Recording for snapshots ===
+
+// Option values are recorded in help mode too, as a later option named -h or --help can end it
+inline bool Parser::isRecording() { return snapshotEnabled_; }
+
+// Starts a new item for an option, the names are stored without the dashes
+inline void Parser::recordOption(InternalData &data, std::string_view shortOpt, std::string_view longOpt, unsigned count) {
+    recordItem(data, shortOpt.substr(std::min<size_t>(1, shortOpt.size())), longOpt.substr(std::min<size_t>(2, longOpt.size())), count);
+}
+
+// Starts a new item, a positional argument only has the long name
+inline void Parser::recordItem(InternalData &data, std::string_view shortName, std::string_view longName, unsigned count) {
+    auto store = [&data](std::string_view name) -> TextSlice {
+        auto offset = data.snapshotText.size();
+        data.snapshotText.append(name);
+        return {static_cast<std::uint32_t>(offset), static_cast<std::uint32_t>(name.size())};
+    };
+
+    auto shortSlice = store(shortName);
+    auto longSlice  = store(longName);
+    data.snapshotItems.push_back({shortSlice, longSlice, count, static_cast<std::uint32_t>(data.snapshotValues.size()), 0});
+}
+
+// Appends a value to the last item
+inline void Parser::recordValue(InternalData &data, std::string_view value) {
+    auto offset = data.snapshotText.size();
+    data.snapshotText.append(value);
+    data.snapshotValues.push_back({static_cast<std::uint32_t>(offset), static_cast<std::uint32_t>(value.size())});
+    data.snapshotItems.back().valueCount++;
+}
+
+template <typename T>
+inline void Parser::recordValueOf(InternalData &data, const T &value) {
+    using DecayedT = remove_cvref_t<T>;
+
+    if constexpr (isOptionalType<T>::value) {
+        if (value) { recordValueOf(data, *value); }
+    } else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+        recordValue(data, std::string_view(value));
+    } else if constexpr (std::is_floating_point_v<DecayedT>) {
+        // The shortest text that reads back to the same value, `toString()` rounds for the help message
+        char buf[64]; // NOLINT(readability-magic-numbers)
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto res = std::to_chars(buf, buf + sizeof(buf), value);
+        recordValue(data, std::string_view(buf, res.ptr - buf));
+#else
+        std::snprintf(buf, sizeof(buf), "%.17g", static_cast<double>(value));
+        recordValue(data, buf);
+#endif
+    } else {
+        recordValue(data, toString(value));
+    }
+}
+
+inline std::shared_ptr<const ParsedArgs> Parser::snapshot_(const InternalData &data) {
+    size_t entryCount = 0;
+    for (const auto &item : data.snapshotItems) {
+        entryCount += (item.shortName.size != 0 ? 1 : 0) + (item.longName.size != 0 ? 1 : 0);
+    }
+
+    std::shared_ptr<ParsedArgs> args(new ParsedArgs(entryCount, data.snapshotValues.size(), data.snapshotText.size()));
+
+    // The offsets stay valid, as the text is copied as a whole
+    std::copy(data.snapshotText.begin(), data.snapshotText.end(), args->mutableText());
+    auto *values = args->mutableValues();
+    for (size_t i = 0; i < data.snapshotValues.size(); i++) {
+        ::new (&values[i]) ParsedArgs::Slice{data.snapshotValues[i].offset, data.snapshotValues[i].size};
+    }
+
+    auto  *entries = args->mutableEntries();
+    size_t idx     = 0;
+    for (const auto &item : data.snapshotItems) {
+        for (const auto &name : {item.shortName, item.longName}) {
+            if (name.size == 0) { continue; }
+            ::new (&entries[idx++]) ParsedArgs::Entry{name.offset, name.size, item.count, item.firstValue, item.valueCount};
+        }
+    }
+    // Keep the declaration order among entries with the same name, the first one is found
+    std::stable_sort(entries, entries + entryCount, [&args](const ParsedArgs::Entry &a, const ParsedArgs::Entry &b) {
+        return args->name(a) < args->name(b);
+    });
+
+    return args;
+}
+
+} // namespace ArgLite
@@ -4,9 +4,9 @@
 #include "Formatter.hpp"
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
-#include <iomanip>
-#include <iostream>
+#include <cstring>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -16,11 +16,17 @@
 namespace ArgLite {
 
 inline void Parser::preprocess_(int argc, const char *const *argv) { // NOLINT(readability-function-cognitive-complexity)
-    argc_ = argc;
-    argv_ = argv;
+    lockParse();
+
+    argc_        = argc;
+    argv_        = argv;
+    argvTailIdx_ = argc;
+    unknownArgs_.clear();
 
     auto &data = data_;
 
+    activeSubCmd_ = nullptr;
+
     std::string_view shortNonFlagOptsStr = mainCmdShortNonFlagOptsStr_;
 
     // Set up the program name
@@ -51,9 +57,27 @@ inline void Parser::preprocess_(int argc, const char *const *argv) { // NOLINT(r
         }
     }
 
+    // The whole argument is the value
+    auto wholeArg = [argv](int idx) -> OptionInfo {
+        return {idx, 0, static_cast<std::uint32_t>(std::strlen(argv[idx]))};
+    };
+    // The value starts at `offset` of the argument
+    auto argSuffix = [](int idx, std::string_view arg, size_t offset) -> OptionInfo {
+        return {idx, static_cast<std::uint32_t>(offset), static_cast<std::uint32_t>(arg.size() - offset)};
+    };
+    auto flag = [](int idx) -> OptionInfo { return {-idx, 0, 0}; };
+    // Without declarations, a separated value is taken by any option unless the parsing stops at the first positional
+    auto takesLongValue = [](std::string_view longOpt) {
+        return !stopAtFirstPositional_ ||
+               std::find(longNonFlagOpts_.begin(), longNonFlagOpts_.end(), longOpt.substr(2)) != longNonFlagOpts_.end();
+    };
+    auto takesShortValue = [&shortNonFlagOptsStr](char shortOpt) {
+        return !stopAtFirstPositional_ || shortNonFlagOptsStr.find(shortOpt) != std::string_view::npos;
+    };
+
     bool allPositional = false;
     for (int i = 1 + subCmdOffset; i < argc; ++i) {
-        std::string arg = argv[i];
+        std::string_view arg = argv[i];
 
         if (allPositional) {
             data.positionalArgsIndices.push_back(i);
@@ -61,86 +85,106 @@ inline void Parser::preprocess_(int argc, const char *const *argv) { // NOLINT(r
         }
 
         if (arg.length() <= 1) { // Not an option, an option has 2 chars at least (e.g., -h)
+            if (stopAtFirstPositional_) {
+                argvTailIdx_ = i;
+                break;
+            }
             data.positionalArgsIndices.push_back(i);
             continue;
         }
 
         if (arg == "--") {
+            if (stopAtFirstPositional_) {
+                argvTailIdx_ = i + 1;
+                break;
+            }
             allPositional = true;
             continue;
         }
 
         // Long option
         if (arg.rfind("--", 0) == 0) {
-            std::string key = arg;
-            std::string value;
             // --opt=val form
-            if (auto equalsPos = arg.find('='); equalsPos != std::string::npos) {
-                key   = arg.substr(0, equalsPos);
-                value = arg.substr(equalsPos + 1);
-                data.options[key].push_back({i, std::move(value)});
+            if (auto equalsPos = arg.find('='); equalsPos != std::string_view::npos) {
+                data.options[newString(arg.substr(0, equalsPos), data)].push_back(argSuffix(i, arg, equalsPos + 1));
             } else {
-                if (i + 1 < argc && argv[i + 1][0] != '-') {
-                    data.options[key].push_back({i + 1, ""});
+                auto &optInfoArr = data.options[newString(arg, data)];
+                if (i + 1 < argc && argv[i + 1][0] != '-' && takesLongValue(arg)) {
+                    optInfoArr.push_back(wholeArg(i + 1));
                     i++; // Consume next arg as value
                 } else {
-                    data.options[key].push_back({-i, ""}); // Flag
+                    optInfoArr.push_back(flag(i));
                 }
             }
         }
         // Short option(s)
         // Process short options, e.g., -n 123, -ab, -abn 123, -n123, -abn123
         else if (arg.rfind('-', 0) == 0) {
-            std::string lastFlagKey;
-            bool        isValueConsumedInCurrentArg = false; // True if a short option like -n123 was found
+            OptionInfoArr *lastFlagArr                 = nullptr;
+            bool           isValueConsumedInCurrentArg = false; // True if a short option like -n123 was found
 
             for (size_t j = 1; j < arg.length(); ++j) {
-                std::string currentOptKey = "-";
-                currentOptKey += arg[j];
+                char  currentOptKey[] = {'-', arg[j]};
+                auto &optInfoArr      = data.options[newString({currentOptKey, 2}, data)];
 
                 // Check if the current character is a short option that requires a value
                 if (shortNonFlagOptsStr.find(arg[j]) != std::string::npos && j + 1 < arg.length()) {
                     // `-n123` or `-abn123` form. It requires a value, the rest of the string is its value
-                    std::string value = arg.substr(j + 1);
-                    data.options[currentOptKey].push_back({i, std::move(value)});
+                    optInfoArr.push_back(argSuffix(i, arg, j + 1));
                     isValueConsumedInCurrentArg = true;
                     break; // Stop processing this argument, as the rest is a value for this option
                 }
 
                 // It's a flag
-                data.options[currentOptKey].push_back({-i, ""});
+                optInfoArr.push_back(flag(i));
                 // Keep track of the last flag, in case it needs to consume the next argument
-                lastFlagKey = currentOptKey;
+                lastFlagArr = &optInfoArr;
             }
 
             // `-n 123` or `-abn 123` form
             // If no value was consumed within the current argument (not `-n123` form)
             // and there was a last flag, check if it takes a value from the next argument.
-            if (!isValueConsumedInCurrentArg && !lastFlagKey.empty()) {
+            if (!isValueConsumedInCurrentArg && lastFlagArr != nullptr) {
                 // This condition applies to the *last* flag in a bundle (e.g., 'n' in '-abn 123')
                 // or a single short option (e.g., 'n' in '-n 123').
                 // If the next argument exists and is not another option, it's the value.
-                if (i + 1 < argc && argv[i + 1][0] != '-') {
+                if (i + 1 < argc && argv[i + 1][0] != '-' && takesShortValue(arg.back())) {
                     // It was treated as a flag, correct it
-                    data.options[lastFlagKey].back() = {i + 1, ""};
+                    lastFlagArr->back() = wholeArg(i + 1);
                     i++; // Consume the next argument
                 }
             }
         }
         // Positional
         else {
+            if (stopAtFirstPositional_) {
+                argvTailIdx_ = i;
+                break;
+            }
             data.positionalArgsIndices.push_back(i);
         }
     }
+
+    data.helpRequested = (data.options.count("-h") != 0) || (data.options.count("--help") != 0);
+
+    // Print the version right away, nothing declared later can affect it.
+    // In the embedded mode, it is printed in post-processing, which reports it.
+    if (!embedded_ && !programVersion_.empty() && isMainCmdActive() &&
+        ((data.options.count("-V") != 0) || (data.options.count("--version") != 0))) {
+        outSink_.write(std::string(programVersion_).append("\n"));
+        std::exit(EXIT_SUCCESS);
+    }
 }
 
-inline void Parser::tryToPrintVersion_(InternalData &data) {
-    if (programVersion_.empty() || !isMainCmdActive()) { return; }
-    data.optionHelpEntries.push_back({"-V", "--version", "Show version information and exit", ""});
+inline bool Parser::tryToPrintVersion_(InternalData &data) {
+    if (programVersion_.empty() || !isMainCmdActive()) { return false; }
+    pushOptionHelp(data, "-V", "--version", "Show version information and exit");
     if ((data.options.count("-V") != 0) || (data.options.count("--version")) != 0) {
-        std::cout << programVersion_ << '\n';
-        std::exit(EXIT_SUCCESS);
+        outSink_.write(std::string(programVersion_).append("\n"));
+        if (!embedded_) { std::exit(EXIT_SUCCESS); }
+        return true;
     }
+    return false;
 }
 
 inline bool Parser::tryToPrintInvalidOpts_(InternalData &data, bool notExit) {
@@ -148,77 +192,132 @@ inline bool Parser::tryToPrintInvalidOpts_(InternalData &data, bool notExit) {
     data.options.erase("-h");
     data.options.erase("--help");
 
+    if (passThroughUnknown_) { collectUnknownArgs(data); }
+
     if (!data.options.empty()) {
+        auto        errorStr = Formatter::styled("Error: ", Formatter::Style::Red, errSink_);
+        std::string out;
         for (const auto &pair : data.options) {
-            std::cerr << ERROR_STR << "Unrecognized option '";
-            std::cerr << Formatter::bold(pair.first, std::cerr);
-            std::cerr << "'\n";
+            errorStr.appendTo(out);
+            out.append("Unrecognized option '");
+            Formatter::append(out, pair.first, Formatter::Style::Bold, errSink_);
+            out.append("'\n");
         }
-        if (!notExit) { std::exit(EXIT_FAILURE); }
+        errSink_.write(out);
+        if (!notExit && !embedded_) { std::exit(EXIT_FAILURE); }
         return true;
     }
 
     return false;
 }
 
-inline void Parser::tryToPrintHelp_(InternalData &data) {
-    tryToPrintVersion_(data);
+// Moves the unknown options out of the options map, as views of their arguments in argv
+inline void Parser::collectUnknownArgs(InternalData &data) {
+    std::vector<int> indices;
+    for (auto it = data.options.begin(); it != data.options.end();) {
+        // Help options are handled by tryToPrintHelp
+        if (it->first == "-h" || it->first == "--help") {
+            ++it;
+            continue;
+        }
+        for (const auto &optInfo : it->second) {
+            if (optInfo.argvIndex < 0) { // A flag
+                indices.push_back(-optInfo.argvIndex);
+            } else if (optInfo.argvIndex > 0) {
+                // A separated value follows its option, an inner value is part of the option argument
+                if (optInfo.valueOffset == 0) { indices.push_back(optInfo.argvIndex - 1); }
+                indices.push_back(optInfo.argvIndex);
+            }
+        }
+        it = data.options.erase(it);
+    }
+    if (indices.empty()) { return; }
+
+    // A bundle of short options has one occurrence per option, keep the argument once
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
 
-    if ((data.options.count("-h") != 0) || (data.options.count("--help")) != 0) {
-        data.optionHelpEntries.push_back({"-h", "--help", "Show this help message and exit", ""});
+    // The map is empty after the first call, except for help options, so this runs once per command line
+    unknownArgs_.reserve(indices.size());
+    for (int idx : indices) { unknownArgs_.push_back(argv_[idx]); }
+}
+
+inline Parser::ParseStatus Parser::tryToPrintHelp_(InternalData &data) {
+    if (tryToPrintVersion_(data)) { return ParseStatus::VersionPrinted; }
+
+    if (data.helpRequested) {
+        // A name taken by a declared option is not listed again
+        std::string_view shortOpt = "-h";
+        std::string_view longOpt  = "--help";
+        for (const auto &entry : data.optionHelpEntries) {
+            if (entry.isOptHeader) { continue; }
+            if (viewHelpStr(entry.shortOpt, data) == shortOpt) { shortOpt = {}; }
+            if (viewHelpStr(entry.longOpt, data) == longOpt) { longOpt = {}; }
+        }
+        pushOptionHelp(data, shortOpt, longOpt, "Show this help message and exit");
         printHelp(data);
-        std::exit(EXIT_SUCCESS);
+        if (!embedded_) { std::exit(EXIT_SUCCESS); }
+        return ParseStatus::HelpPrinted;
     }
+    return ParseStatus::Ok;
 }
 
 inline void Parser::printHelp(const InternalData &data) {
+    std::string out;
+    renderHelp(data, out);
+
+    // Emit the whole page at once
+    outSink_.write(out);
+}
+
+inline void Parser::renderHelp(const InternalData &data, std::string &out) {
     std::string_view description = programDescription_;
     if (activeSubCmd_ != nullptr) { description = activeSubCmd_->subCmdDescription_; }
-    printHelpDescription(description);
-    printHelpUsage(data, data_.cmdName);
-    printHelpSubCmd(subCmdPtrs_);
-    printHelpPositional(data);
-    printHelpOptions(data);
+    renderHelpDescription(out, description);
+    renderHelpUsage(out, data, data_.cmdName);
+    renderHelpSubCmd(out, subCmdPtrs_);
+    renderHelpPositional(out, data);
+    renderHelpOptions(out, data);
 
     if (!data.helpFooter.empty()) {
-        std::cout << '\n'
-                  << data.helpFooter << '\n';
+        out.append("\n").append(data.helpFooter).append("\n");
     }
 }
 
-inline void Parser::printHelpDescription(std::string_view description) {
+inline void Parser::renderHelpDescription(std::string &out, std::string_view description) {
     if (!description.empty()) {
-        std::cout << description << '\n'
-                  << '\n';
+        out.append(description).append("\n\n");
     }
 }
 
-inline void Parser::printHelpUsage(const InternalData &data, std::string_view cmdName) {
-    std::cout << "Usage: ";
-    std::cout << Formatter::bold(cmdName);
-    if (!subCmdPtrs_.empty() && isMainCmdActive()) { std::cout << " [SUBCOMMAND]"; }
-    if (!data.optionHelpEntries.empty()) { std::cout << " [OPTIONS]"; }
+inline void Parser::renderHelpUsage(std::string &out, const InternalData &data, std::string_view cmdName) {
+    out.append("Usage: ");
+    Formatter::append(out, cmdName, Formatter::Style::Bold, outSink_);
+    if (!subCmdPtrs_.empty() && isMainCmdActive()) { out.append(" [SUBCOMMAND]"); }
+    if (!data.optionHelpEntries.empty()) { out.append(" [OPTIONS]"); }
 
     // Print required options
     for (const auto &o : data.optionHelpEntries) {
         if (o.isRequired) {
-            std::cout << ' ' << o.longOpt << "=<" << o.typeName << ">";
+            out.append(" ").append(viewHelpStr(o.longOpt, data));
+            out.append("=<").append(viewHelpStr(o.typeName, data)).append(">");
         }
     }
 
     // Print positional arguments
     for (const auto &p : data.positionalHelpEntries) {
-        std::cout << " " << (p.isRequired ? "" : "[") << p.name << (p.isRequired ? "" : "]");
-        if (p.isRemaining) { std::cout << "..."; }
+        out.append(p.isRequired ? " " : " [").append(viewHelpStr(p.name, data)).append(p.isRequired ? "" : "]");
+        if (p.isRemaining) { out.append("..."); }
     }
-    std::cout << '\n';
+    out.append("\n");
 }
 
-inline void Parser::printHelpSubCmd(const std::vector<SubParser *> &subCmdPtrs) {
+inline void Parser::renderHelpSubCmd(std::string &out, const std::vector<SubParser *> &subCmdPtrs) {
     if (subCmdPtrs.empty() || !isMainCmdActive()) { return; }
 
-    std::cout << '\n'
-              << Formatter::boldUnderline("Subcommands:") << '\n';
+    out.append("\n");
+    Formatter::append(out, "Subcommands:", Formatter::Style::BoldUnderline, outSink_);
+    out.append("\n");
 
     size_t maxSubCmdNameWidth = 0;
     for (const auto &p : subCmdPtrs) {
@@ -226,122 +325,286 @@ inline void Parser::printHelpSubCmd(const std::vector<SubParser *> &subCmdPtrs)
     }
 
     for (const auto &p : subCmdPtrs) {
-        std::cout << "  " << std::left
-                  << std::setw(static_cast<int>(maxSubCmdNameWidth) + 3 + ANSI_CODE_LENGTH)
-                  << Formatter::bold(p->subCommandName_) << p->subCmdDescription_ << '\n';
+        out.append("  ");
+        Formatter::append(out, p->subCommandName_, Formatter::Style::Bold, outSink_);
+        appendPadding(out, p->subCommandName_.length(), maxSubCmdNameWidth + 3);
+        out.append(p->subCmdDescription_).append("\n");
     }
 }
 
-inline void Parser::printHelpPositional(const InternalData &data) {
+inline void Parser::renderHelpPositional(std::string &out, const InternalData &data) {
     if (data.positionalHelpEntries.empty()) { return; }
 
     // Print header
-    std::cout << '\n'
-              << Formatter::boldUnderline("Positional Arguments:") << '\n';
+    out.append("\n");
+    Formatter::append(out, "Positional Arguments:", Formatter::Style::BoldUnderline, outSink_);
+    out.append("\n");
 
     size_t maxNameWidth = 0;
     for (const auto &p : data.positionalHelpEntries) {
-        maxNameWidth = std::max(maxNameWidth, p.name.length());
+        maxNameWidth = std::max(maxNameWidth, static_cast<size_t>(p.name.size));
     }
     // Print each positional argument
     for (const auto &p : data.positionalHelpEntries) {
         // Print name
-        std::cout << "  " << std::left;
-        std::cout << std::setw(static_cast<int>(maxNameWidth) + 2 + ANSI_CODE_LENGTH)
-                  << Formatter::bold(p.name);
+        out.append("  ");
+        Formatter::append(out, viewHelpStr(p.name, data), Formatter::Style::Bold, outSink_);
+        appendPadding(out, p.name.size, maxNameWidth + 2);
 
         // Print description
-        std::string descStr = p.description;
-        if (!p.defaultValue.empty()) {
-            descStr.append(" [default: ").append(p.defaultValue).append("]");
+        out.append(viewHelpStr(p.description, data));
+        if (p.defaultValue.size != 0) {
+            out.append(" [default: ").append(viewHelpStr(p.defaultValue, data)).append("]");
         }
-        std::cout << descStr << '\n';
+        out.append("\n");
     }
 }
 
-inline void Parser::printHelpOptions(const InternalData &data) {
+inline void Parser::renderHelpOptions(std::string &out, const InternalData &data) {
     if (data.optionHelpEntries.empty()) { return; }
 
     // Print header
     if (!data.hasCustumOptHeader) {
-        std::cout << '\n'
-                  << Formatter::boldUnderline("Options:") << '\n';
+        out.append("\n");
+        Formatter::append(out, "Options:", Formatter::Style::BoldUnderline, outSink_);
+        out.append("\n");
     }
 
+    // Reused for every option, so the names and descriptions are not allocated one by one
+    std::string optStr;
+    std::string descStr;
+
     // Print each option
     for (const auto &o : data.optionHelpEntries) {
         // It is a option header
         if (o.isOptHeader) {
-            std::cout << '\n';
-            std::cout << Formatter::boldUnderline(o.shortOpt + ":\n");
+            out.append("\n");
+            optStr.assign(viewHelpStr(o.shortOpt, data)).append(":\n");
+            Formatter::append(out, optStr, Formatter::Style::BoldUnderline, outSink_);
             continue;
         }
 
+        auto shortOpt     = viewHelpStr(o.shortOpt, data);
+        auto longOpt      = viewHelpStr(o.longOpt, data);
+        auto typeName     = viewHelpStr(o.typeName, data);
+        auto defaultValue = viewHelpStr(o.defaultValue, data);
+        auto envName      = viewHelpStr(o.envName, data);
+
         // Print name
-        std::string optStr("  ");
-        if (!o.shortOpt.empty()) {
-            optStr += o.shortOpt;
-            if (!o.longOpt.empty()) { optStr += ", "; }
+        optStr.assign("  ");
+        if (!shortOpt.empty()) {
+            optStr += shortOpt;
+            if (!longOpt.empty()) { optStr += ", "; }
         } else {
             optStr += "    "; // Pad for alignment
         }
-        optStr += o.longOpt;
+        optStr += longOpt;
 
-        std::cout << std::left;
-        std::cout << std::setw(static_cast<int>(descriptionIndent_) + ANSI_CODE_LENGTH);
-        optStr = Formatter::bold(optStr);
+        // Length of the option part without ANSI sequences
+        auto optPartLength = optStr.length();
+        Formatter::append(out, optStr, Formatter::Style::Bold, outSink_);
 
-        if (!o.typeName.empty()) {
-            optStr.append(" <").append(o.typeName).append(">");
+        if (!typeName.empty()) {
+            out.append(" <").append(typeName).append(">");
+            optPartLength += typeName.length() + 3;
         }
-        std::cout << optStr;
 
         // Print description
-        std::string descStr = o.description;
-        if (!o.defaultValue.empty()) {
-            descStr.append(" [default: ").append(o.defaultValue).append("]");
+        descStr.assign(viewHelpStr(o.description, data));
+        if (!defaultValue.empty()) {
+            descStr.append(" [default: ").append(defaultValue).append("]");
         }
+        if (!envName.empty()) { descStr.append(" [env: ").append(envName).append("]"); }
         if (o.isMutualExDefault) { descStr.append(" (default)"); }
 
-        auto optPartLength = optStr.length();
-        optPartLength -= ANSI_CODE_LENGTH;
         // the option string is too long, start a new line
         // -2: two separeting spaces after the type name
         if (optPartLength > descriptionIndent_ - 2) {
-            std::cout << '\n';
-            printWithIndent(descStr, static_cast<int>(descriptionIndent_), true);
+            out.append("\n");
+            appendWithIndent(out, descStr, descriptionIndent_, true);
         } else {
-            printWithIndent(descStr, static_cast<int>(descriptionIndent_));
+            appendPadding(out, optPartLength, descriptionIndent_);
+            appendWithIndent(out, descStr, descriptionIndent_);
         }
     }
 }
 
 // Clear internal data
 inline void Parser::clearData(InternalData &data) {
+    // Keep the memory of the containers for the next command line
+    if (embedded_ && !usesCustomResource(data)) {
+        data.cmdName.clear();
+        data.positionalIdx      = 0;
+        data.hasCustumOptHeader = false;
+        data.helpRequested      = false;
+        data.options.clear();
+        data.optionHelpEntries.clear();
+        data.positionalArgsIndices.clear();
+        data.positionalHelpEntries.clear();
+        data.errors.clear();
+        data.customErrorMessages.clear();
+        data.helpArena.clear();
+        data.snapshotItems.clear();
+        data.snapshotValues.clear();
+        data.snapshotText.clear();
+        data.permuteBuffer.clear();
+        unlockParse();
+        return;
+    }
+
+#ifdef ARGLITE_ENABLE_PMR
+    // Switch back to the default resource, the resource set by the user may be gone after the parsing
+    resetData(data, std::pmr::get_default_resource(), releaseAtOnce_);
+    releaseAtOnce_ = false;
+#else
     data.cmdName.clear();
     data.positionalIdx = 0;
+    data.helpRequested = false;
 
     InternalData temp;
     temp.options.swap(data.options);
     temp.optionHelpEntries.swap(data.optionHelpEntries);
     temp.positionalArgsIndices.swap(data.positionalArgsIndices);
     temp.positionalHelpEntries.swap(data.positionalHelpEntries);
-    temp.errorMessages.swap(data.errorMessages);
+    temp.errors.swap(data.errors);
+    temp.customErrorMessages.swap(data.customErrorMessages);
+    temp.helpArena.swap(data.helpArena);
+    temp.snapshotItems.swap(data.snapshotItems);
+    temp.snapshotValues.swap(data.snapshotValues);
+    temp.snapshotText.swap(data.snapshotText);
+    temp.permuteBuffer.swap(data.permuteBuffer);
+#endif
+
+    unlockParse();
+}
+
+inline bool Parser::usesCustomResource([[maybe_unused]] const InternalData &data) {
+#ifdef ARGLITE_ENABLE_PMR
+    return data.helpArena.get_allocator().resource() != std::pmr::get_default_resource();
+#else
+    return false;
+#endif
+}
+
+#ifdef ARGLITE_ENABLE_PMR
+// Recreates the internal data with the resource. The help footer is kept as it can be set before `preprocess()`
+inline void Parser::resetData(InternalData &data, std::pmr::memory_resource *resource, bool abandon) {
+    auto helpFooter = data.helpFooter;
+    // A resource that releases all memory at once does not need the elements to be freed one by one
+    if (!abandon) { data.~InternalData(); }
+    ::new (&data) InternalData(resource);
+    data.helpFooter = helpFooter;
+}
+#endif
+
+// Renders the message of an error, the names and the custom messages are looked up in the internal data
+inline void Parser::appendErrorMsg(std::string &out, const ParseError &error, const InternalData &data, const OutputSink &sink) {
+    auto bold   = [&out, &sink](std::string_view sv) { Formatter::append(out, sv, Formatter::Style::Bold, sink); };
+    auto yellow = [&out, &sink](std::string_view sv) { Formatter::append(out, sv, Formatter::Style::Yellow, sink); };
+    // Option names are printed as "-o, --out" in bold
+    auto optName = [&]() {
+        const auto &entry    = data.optionHelpEntries[error.handle];
+        auto        shortOpt = viewHelpStr(entry.shortOpt, data);
+        auto        longOpt  = viewHelpStr(entry.longOpt, data);
+
+        std::string name(shortOpt);
+        if (!shortOpt.empty() && !longOpt.empty()) { name.append(", "); }
+        bold(name.append(longOpt));
+    };
+    auto posName = [&]() { bold(viewHelpStr(data.positionalHelpEntries[error.handle].name, data)); };
+
+    switch (error.code) {
+    case ErrorCode::InvalidValue:
+        out.append("Invalid value for option '");
+        optName();
+        out.append("'. Expected a ");
+        bold(error.typeName);
+        out.append(", but got '");
+        yellow(error.value);
+        out.append("'.");
+        break;
+    case ErrorCode::InvalidEnvValue:
+        out.append("Invalid value for environment variable '");
+        bold(viewHelpStr(data.optionHelpEntries[error.handle].envName, data));
+        out.append("' of option '");
+        optName();
+        out.append("'. Expected a ");
+        bold(error.typeName);
+        out.append(", but got '");
+        yellow(error.value);
+        out.append("'.");
+        break;
+    case ErrorCode::InvalidConfigValue:
+        out.append("Invalid value for key '");
+        bold(viewHelpStr(data.optionHelpEntries[error.handle].longOpt, data).substr(2));
+#ifdef ARGLITE_ENABLE_CONFIG_FILE
+        out.append("' in the config file '").append(config_.path());
+#endif
+        out.append("' of option '");
+        optName();
+        out.append("'. Expected a ");
+        bold(error.typeName);
+        out.append(", but got '");
+        yellow(error.value);
+        out.append("'.");
+        break;
+    case ErrorCode::MissingValue:
+        out.append("Option '");
+        optName();
+        out.append("' requires a value.");
+        break;
+    case ErrorCode::MissingOption:
+        out.append("Option '");
+        optName();
+        out.append("' is required, you cannot run this command without it.");
+        break;
+    case ErrorCode::InvalidPositional:
+        out.append("Invalid value for positional argument '");
+        posName();
+        out.append("'. Expected a ");
+        bold(error.typeName);
+        out.append(", but got '");
+        yellow(error.value);
+        out.append("'.");
+        break;
+    case ErrorCode::MissingPositional:
+        out.append(data.positionalHelpEntries[error.handle].isRemaining
+                       ? "Missing required positional arguments '"
+                       : "Missing required positional argument '");
+        posName();
+        out.append("'.");
+        break;
+    case ErrorCode::DuplicateKey:
+        out.append("Duplicate key '");
+        yellow(error.value);
+        out.append("' for option '");
+        optName();
+        out.append("'.");
+        break;
+    case ErrorCode::Custom:
+        out.append(data.customErrorMessages[error.handle]);
+        break;
+    }
 }
 
 inline bool Parser::finalize_(InternalData &data, bool notExit) {
-    if (data.errorMessages.empty()) {
+    if (data.errors.empty()) {
         clearData(data);
         return false;
     }
 
-    std::cerr << "Errors occurred while parsing command-line arguments.\n";
-    std::cerr << "The following is a list of error messages:\n";
-    for (const auto &msg : data.errorMessages) {
-        std::cerr << ERROR_STR << msg << '\n';
+    auto        errorStr = Formatter::styled("Error: ", Formatter::Style::Red, errSink_);
+    std::string out;
+    out.append("Errors occurred while parsing command-line arguments.\n");
+    out.append("The following is a list of error messages:\n");
+    for (const auto &error : data.errors) {
+        errorStr.appendTo(out);
+        appendErrorMsg(out, error, data, errSink_);
+        out.append("\n");
     }
+    errSink_.write(out);
 
-    if (notExit) {
+    if (notExit || embedded_) {
         clearData(data);
         return true;
     }
@@ -349,17 +612,32 @@ inline bool Parser::finalize_(InternalData &data, bool notExit) {
 }
 
 inline bool Parser::runAllPostprocess_(InternalData &data, bool notExit) {
-    tryToPrintHelp_(data);
-    auto hasInvalidOpts = tryToPrintInvalidOpts_(data, true);
-    auto hasError       = finalize_(data, true);
+    auto hasError = postprocess_(data) == ParseStatus::Error;
 
-    if (!notExit && (hasInvalidOpts || hasError)) {
+    if (!notExit && !embedded_ && hasError) {
         std::exit(EXIT_FAILURE);
     }
-    return hasInvalidOpts || hasError;
+    return hasError;
+}
+
+inline Parser::ParseStatus Parser::postprocess_(InternalData &data) {
+    // Unless it is in the embedded mode, the program has exited if the help or the version is printed
+    if (auto status = tryToPrintHelp_(data); status != ParseStatus::Ok) {
+        clearData(data);
+        return status;
+    }
+
+    auto hasInvalidOpts = tryToPrintInvalidOpts_(data, true);
+    auto hasError       = finalize_(data, true);
+    return hasInvalidOpts || hasError ? ParseStatus::Error : ParseStatus::Ok;
+}
+
+// Appends spaces to pad a field of `length` visible characters to `width`
+inline void Parser::appendPadding(std::string &out, size_t length, size_t width) {
+    if (length < width) { out.append(width - length, ' '); }
 }
 
-inline void Parser::printWithIndent(std::string_view sv, int indent, bool indentFirstLine) {
+inline void Parser::appendWithIndent(std::string &out, std::string_view sv, size_t indent, bool indentFirstLine) {
     size_t nextNewlinePos = sv.find('\n');
     size_t currentPos     = 0;
 
@@ -373,22 +651,22 @@ inline void Parser::printWithIndent(std::string_view sv, int indent, bool indent
         currentPos = sv.size();
     }
 
-    if (indentFirstLine) { std::cout << std::setw(indent) << ""; }
-    std::cout << firstLine << '\n';
+    if (indentFirstLine) { out.append(indent, ' '); }
+    out.append(firstLine).append("\n");
 
     // Print the rest of the lines
     while (currentPos < sv.size()) {
         nextNewlinePos = sv.find('\n', currentPos);
 
-        std::cout << std::setw(indent) << "";
+        out.append(indent, ' ');
 
         // Print the remaining part
         if (nextNewlinePos == std::string_view::npos) {
-            std::cout << sv.substr(currentPos) << '\n';
+            out.append(sv.substr(currentPos)).append("\n");
             break;
         }
 
-        std::cout << sv.substr(currentPos, nextNewlinePos - currentPos) << '\n';
+        out.append(sv.substr(currentPos, nextNewlinePos - currentPos)).append("\n");
         currentPos = nextNewlinePos + 1;
     }
 }
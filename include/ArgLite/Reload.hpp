@@ -0,0 +1,255 @@
+#pragma once
+
+#ifndef ARGLITE_ENABLE_CONFIG_FILE
+#error "Reload.hpp requires ARGLITE_ENABLE_CONFIG_FILE to be defined before including ArgLite"
+#endif
+
+#include "Core.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace ArgLite {
+
+/**
+ * @brief Reloads the config file and publishes immutable snapshots that readers access without locking.
+ * @details `reload()` parses the command line and the config file again, calling the declaration function
+ *          that calls the get functions like the startup code, and publishes a new `ParsedArgs` snapshot.
+ *          A reader pins the current snapshot with `read()`, an RCU-style read-side section that only updates
+ *          an atomic counter, and a previous snapshot is freed once the readers that may see it are done.
+ *          Only one thread should call `reload()` or `poll()`. A parse of another thread, from `preprocess()` to
+ *          post-processing, waits for a reload to finish and the other way round, so a thread that never
+ *          post-processes its parse blocks the reloads.
+ */
+class ConfigReloader {
+    // One counter per cache line, so readers on different cores don't write the same line
+    struct alignas(64) Counter { // NOLINT(readability-magic-numbers)
+        std::atomic<long> value{0};
+    };
+
+public:
+    /**
+     * @brief Pins a snapshot, it is not freed while the guard is alive.
+     */
+    class ReadGuard {
+    public:
+        ReadGuard(const ReadGuard &)            = delete;
+        ReadGuard &operator=(const ReadGuard &) = delete;
+        ReadGuard(ReadGuard &&other) noexcept : counter_(other.counter_), args_(other.args_) { other.counter_ = nullptr; }
+        ReadGuard &operator=(ReadGuard &&) = delete;
+        ~ReadGuard() {
+            if (counter_ != nullptr) { counter_->fetch_sub(1, std::memory_order_release); }
+        }
+
+        // Null if no snapshot has been published yet
+        [[nodiscard]]
+        const ParsedArgs *get() const { return args_; }
+        const ParsedArgs *operator->() const { return args_; }
+        const ParsedArgs &operator*() const { return *args_; }
+        explicit operator bool() const { return args_ != nullptr; }
+
+    private:
+        friend class ConfigReloader;
+        ReadGuard(std::atomic<long> *counter, const ParsedArgs *args) : counter_(counter), args_(args) {}
+
+        std::atomic<long> *counter_;
+        const ParsedArgs  *args_;
+    };
+
+    /**
+     * @brief Creates a reloader, nothing is parsed until `reload()` is called.
+     * @param argc The argument count passed to `main()`, the arguments must outlive the reloader.
+     * @param argv The argument vector passed to `main()`.
+     * @param configPath The path of the config file, it is watched for changes.
+     * @param declare The function that calls the get functions, it is called for each reload.
+     */
+    ConfigReloader(int argc, const char *const *argv, std::string configPath, std::function<void()> declare)
+        : argc_(argc), argv_(argv), configPath_(std::move(configPath)), declare_(std::move(declare)) {
+        auto slash = configPath_.find_last_of(PATH_SEPARATORS);
+        fileName_  = slash == std::string::npos ? configPath_ : configPath_.substr(slash + 1);
+        lastStat_  = statFile();
+#ifdef __linux__
+        watchFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (watchFd_ >= 0) {
+            std::string dir = slash == std::string::npos ? "." : configPath_.substr(0, slash == 0 ? 1 : slash);
+            // The directory is watched, as editors often replace the file by renaming a new one
+            if (inotify_add_watch(watchFd_, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+                ::close(watchFd_);
+                watchFd_ = -1;
+            }
+        }
+#endif
+    }
+
+    // Every `ReadGuard` must be destroyed before the reloader
+    ~ConfigReloader() {
+#ifdef __linux__
+        if (watchFd_ >= 0) { ::close(watchFd_); }
+#endif
+    }
+
+    ConfigReloader(const ConfigReloader &)            = delete;
+    ConfigReloader &operator=(const ConfigReloader &) = delete;
+
+    /**
+     * @brief Pins the current snapshot, it never blocks.
+     * @return A guard of the snapshot, which is null if no snapshot has been published yet.
+     */
+    [[nodiscard]]
+    ReadGuard read() const {
+        auto &shard = shards_[shardIndex()];
+        while (true) {
+            auto  epoch   = epoch_.load();
+            auto &counter = shard[epoch & 1].value;
+            counter.fetch_add(1);
+            // The epoch is checked again, so the writer waiting for this parity sees the reader
+            if (epoch_.load() == epoch) { return ReadGuard(&counter, current_.load()); }
+            counter.fetch_sub(1);
+        }
+    }
+
+    /**
+     * @brief Parses the command line and the config file again, and publishes the new snapshot.
+     * @details Errors are printed to the error sink, and the current snapshot is kept if there are any.
+     * @return True if a new snapshot is published, false otherwise.
+     */
+    bool reload() {
+        std::lock_guard<std::mutex> lock(reloadMutex_);
+        // The parser stays locked until the settings are restored, even if `declare` throws
+        Parser::lockParse(true);
+        struct Restore {
+            bool embedded  = Parser::embedded_;
+            bool recording = Parser::snapshotEnabled_;
+            ~Restore() {
+                Parser::embedded_        = embedded;
+                Parser::snapshotEnabled_ = recording;
+                Parser::unlockParse(true);
+            }
+        } restore;
+        if (!Parser::loadConfigFile(configPath_)) { return false; }
+
+        // The daemon keeps running, whatever the new file contains
+        Parser::embedded_        = true;
+        Parser::snapshotEnabled_ = true;
+
+        Parser::preprocess(argc_, argv_);
+        declare_();
+        auto next   = Parser::snapshot();
+        auto status = Parser::postprocess();
+        // The snapshot owns copies of the values, so the mapping is not kept
+        Parser::closeConfigFile();
+        if (status != Parser::ParseStatus::Ok) { return false; }
+
+        publish(std::move(next));
+        return true;
+    }
+
+    /**
+     * @brief Reloads if the config file has changed since the last call, call it periodically or when `fd()` is readable.
+     * @return True if a new snapshot is published, false otherwise.
+     */
+    bool poll() { return hasChanged() && reload(); }
+
+    /**
+     * @brief The inotify descriptor, readable when the config file may have changed.
+     * @return The descriptor, or -1 if inotify is not available and `poll()` compares the modification time.
+     */
+    [[nodiscard]]
+    int fd() const { return watchFd_; }
+
+    /**
+     * @brief The number of snapshots published so far.
+     */
+    [[nodiscard]]
+    std::uint64_t version() const { return version_.load(); }
+
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+#ifdef _WIN32
+    static constexpr const char *PATH_SEPARATORS = "/\\";
+#else
+    static constexpr const char *PATH_SEPARATORS = "/";
+#endif
+
+    struct FileStat {
+        std::time_t mtime;
+        long long   size;
+
+        bool operator==(const FileStat &other) const { return mtime == other.mtime && size == other.size; }
+    };
+
+    // Threads are spread over the shards in the order they first read
+    static size_t shardIndex() {
+        static std::atomic<size_t> nextIndex{0};
+        thread_local size_t        index = nextIndex.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+        return index;
+    }
+
+    FileStat statFile() const {
+        struct stat st{};
+        if (::stat(configPath_.c_str(), &st) != 0) { return {}; }
+        return {st.st_mtime, static_cast<long long>(st.st_size)};
+    }
+
+    bool hasChanged() {
+#ifdef __linux__
+        if (watchFd_ >= 0) {
+            alignas(inotify_event) char buf[4096]; // NOLINT(readability-magic-numbers)
+            bool                        changed = false;
+            ssize_t                     length  = 0;
+            while ((length = ::read(watchFd_, buf, sizeof(buf))) > 0) {
+                for (ssize_t pos = 0; pos < length;) {
+                    const auto *event = reinterpret_cast<const inotify_event *>(buf + pos);
+                    if (event->len > 0 && fileName_ == event->name) { changed = true; }
+                    pos += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                }
+            }
+            return changed;
+        }
+#endif
+        auto current = statFile();
+        if (current == lastStat_) { return false; }
+        lastStat_ = current;
+        return true;
+    }
+
+    // Publishes the snapshot, then waits for the readers that may still see the previous one
+    void publish(std::shared_ptr<const ParsedArgs> next) {
+        current_.store(next.get());
+        auto parity = epoch_.fetch_add(1) & 1;
+        for (auto &shard : shards_) {
+            while (shard[parity].value.load() != 0) { std::this_thread::yield(); }
+        }
+        // The previous snapshot is freed here, off the read path
+        owner_ = std::move(next);
+        version_.fetch_add(1);
+    }
+
+    int                               argc_;
+    const char *const                *argv_;
+    std::string                       configPath_;
+    std::string                       fileName_;
+    std::function<void()>             declare_;
+    FileStat                          lastStat_{};
+    int                               watchFd_ = -1;
+    std::mutex                        reloadMutex_;
+    std::shared_ptr<const ParsedArgs> owner_;
+    std::atomic<const ParsedArgs *>   current_{nullptr};
+    std::atomic<unsigned>             epoch_{0};
+    std::atomic<std::uint64_t>        version_{0};
+    mutable Counter                   shards_[SHARD_COUNT][2];
+};
+
+} // namespace ArgLite
@@ -0,0 +1,26 @@
+#define ARGLITE_NO_IOSTREAM
+#include "ArgLite/Core.hpp"
+#include <cstdio>
+
+using namespace std;
+using ArgLite::Parser;
+
+int main(int argc, char **argv) {
+    Parser::setDescription("ArgLite Full example program");
+    Parser::preprocess(argc, argv);
+
+    auto verbose    = Parser::hasFlag("v,verbose", "Enable verbose mode");
+    auto counter    = Parser::get<int>("c,count", "Counter").get();
+    auto outputFile = Parser::getPositional("output-file", "Output file name");
+    auto inputFiles = Parser::getRemainingPositionals("input-files", "Input file names");
+
+    Parser::runAllPostprocess();
+
+    printf("Verbose    : %s\n", verbose ? "true" : "false");
+    printf("Counter    : %d\n", counter);
+    printf("Output file: %s\n", outputFile.c_str());
+    printf("Input files:\n");
+    for (const auto &it : inputFiles) { printf("  %s\n", it.c_str()); }
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+// Round-trip benchmark of ParsedArgs binary images: re-parsing a long command line
+// compared with serializing the snapshot once and attaching it, e.g., in a forked worker.
+// g++ -std=c++17 -O2 -I../../include image_roundtrip.cpp -o image_roundtrip
+// ./image_roundtrip [positionals] [iterations]
+#include "ArgLite/Core.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using ArgLite::ParsedArgs;
+using ArgLite::Parser;
+
+shared_ptr<const ParsedArgs> parse(int argc, char **argv) {
+    Parser::preprocess(argc, argv);
+    auto verbose = Parser::countFlag("v,verbose", "Verbose output.");
+    auto threads = Parser::get<int>("t,threads", "Number of threads.").setDefault(4).get();
+    auto name    = Parser::get<string>("n,name", "Name.").get();
+    auto ids     = Parser::get<int>("i,id", "Identifiers.").getVec(',');
+    auto inputs  = Parser::getRemainingPositionals("inputs", "Input files.");
+    (void)verbose, (void)threads, (void)name, (void)ids, (void)inputs;
+
+    auto snapshot = Parser::snapshot();
+    Parser::runAllPostprocess();
+    return snapshot;
+}
+
+template <typename F>
+double timeUs(int iterations, F &&func) {
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) { func(); }
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / iterations;
+}
+
+int main(int argc, char **argv) {
+    int positionals = argc > 1 ? atoi(argv[1]) : 1000;
+    int iterations  = argc > 2 ? atoi(argv[2]) : 1000;
+
+    vector<string> args = {"./image_roundtrip", "-vv", "--threads", "16", "--name", "worker", "-i", "1,2,3"};
+    for (int i = 0; i < positionals; i++) { args.push_back("input" + to_string(i) + ".dat"); }
+    vector<char *> cargv;
+    for (auto &arg : args) { cargv.push_back(arg.data()); }
+
+    Parser::setSnapshotEnabled();
+    auto snapshot = parse(static_cast<int>(cargv.size()), cargv.data());
+
+    vector<uint32_t> image((snapshot->imageSize() + 3) / 4);
+    double parseUs     = timeUs(iterations, [&]() { parse(static_cast<int>(cargv.size()), cargv.data()); });
+    double serializeUs = timeUs(iterations, [&]() { snapshot->serialize(image.data(), image.size() * 4); });
+    double attachUs    = timeUs(iterations, [&]() {
+        auto attached = ParsedArgs::attach(image.data(), snapshot->imageSize());
+        if (attached->get<int>("threads") != 16) { exit(1); }
+    });
+
+    printf("Arguments   : %zu\n", args.size());
+    printf("Image size  : %zu bytes\n", snapshot->imageSize());
+    printf("Parse       : %.2f us\n", parseUs);
+    printf("Serialize   : %.2f us\n", serializeUs);
+    printf("Attach      : %.2f us\n", attachUs);
+
+#ifdef __linux__
+    // Hand the image to a child through an inherited memfd
+    int fd = memfd_create("arglite-image", MFD_CLOEXEC);
+    if (fd < 0 || ftruncate(fd, static_cast<off_t>(snapshot->imageSize())) != 0) { return 1; }
+    void *mapping = mmap(nullptr, snapshot->imageSize(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    snapshot->serialize(mapping, snapshot->imageSize());
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        const void *view     = mmap(nullptr, snapshot->imageSize(), PROT_READ, MAP_SHARED, fd, 0);
+        auto        attached = ParsedArgs::attach(view, snapshot->imageSize());
+        bool        ok       = attached && attached->getString("name") == "worker" &&
+                  attached->getVec<string>("inputs").size() == static_cast<size_t>(positionals);
+        _exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    printf("memfd child : %s\n", WIFEXITED(status) && WEXITSTATUS(status) == 0 ? "OK" : "FAILED");
+    munmap(mapping, snapshot->imageSize());
+    close(fd);
+#endif
+
+    return 0;
+}
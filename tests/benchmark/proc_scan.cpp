@@ -0,0 +1,49 @@
+// Benchmark of CmdlineView: the cost of parsing one command line buffer, and of scanning every process in /proc.
+// g++ -std=c++17 -O2 -pthread -I../../include proc_scan.cpp -o proc_scan
+// ./proc_scan [iterations] [threads]
+#include "ArgLite/Cmdline.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace std;
+using ArgLite::CmdlineSchema;
+using ArgLite::CmdlineView;
+
+int main(int argc, char **argv) {
+    int      iterations = argc > 1 ? atoi(argv[1]) : 100000;
+    unsigned threads    = argc > 2 ? static_cast<unsigned>(atoi(argv[2])) : 0;
+
+    CmdlineSchema schema;
+    auto          verbose    = schema.addFlag("v,verbose");
+    auto          threadsOpt = schema.addOption("t,threads");
+    auto          config     = schema.addOption("c,config");
+    auto          port       = schema.addOption("p,port");
+    (void)verbose, (void)config;
+
+    string buffer("/usr/local/bin/server\0-v\0--threads\0" "16\0--config=/etc/server.ini\0-p\0" "8080\0--log-level\0info\0data\0"s);
+
+    CmdlineView view;
+    long        checksum = 0;
+    auto        start    = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        view.parse(schema, buffer);
+        checksum += view.get<int>(threadsOpt) + view.get<int>(port);
+    }
+    double parseUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / iterations;
+    printf("Parse one buffer : %.3f us (checksum %ld)\n", parseUs, checksum);
+
+#ifdef __linux__
+    atomic<size_t> withThreads{0};
+    start       = chrono::steady_clock::now();
+    auto parsed = ArgLite::scanProcCmdlines(schema, [&](int, const CmdlineView &v) {
+        if (v.count(threadsOpt) != 0) { withThreads++; }
+    }, threads);
+    double scanUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+    printf("Scan /proc       : %zu processes in %.1f us (%.2f us per process)\n", parsed, scanUs, parsed == 0 ? 0.0 : scanUs / static_cast<double>(parsed));
+#endif
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+// Stress benchmark of ConfigReloader: one reader per core reads snapshots while the config file is reloaded.
+// g++ -std=c++17 -O2 -pthread -I../../include reload_stress.cpp -o reload_stress
+// ./reload_stress [reloads] [readers]
+#define ARGLITE_ENABLE_CONFIG_FILE
+
+#include "ArgLite/Reload.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using ArgLite::ConfigReloader;
+using ArgLite::Parser;
+
+const string configPath = "/tmp/arglite_reload_stress.ini";
+
+void writeConfig(int value) {
+    string tmpPath = configPath + ".tmp";
+    FILE  *file    = fopen(tmpPath.c_str(), "wb");
+    if (file == nullptr) { exit(1); }
+    fprintf(file, "threads = %d\nworkers = %d\n", value, value * 2);
+    fclose(file);
+    rename(tmpPath.c_str(), configPath.c_str());
+}
+
+int main(int argc, char **argv) {
+    int      reloads = argc > 1 ? atoi(argv[1]) : 1000;
+    unsigned readers = argc > 2 ? static_cast<unsigned>(atoi(argv[2])) : thread::hardware_concurrency();
+    if (readers == 0) { readers = 1; }
+
+    writeConfig(0);
+    static const char *args[] = {"./reload_stress"};
+    ConfigReloader     reloader(1, args, configPath, []() {
+        auto threads = Parser::get<int>("threads", "Number of threads.").get();
+        auto workers = Parser::get<int>("workers", "Number of workers.").get();
+        (void)threads, (void)workers;
+    });
+    reloader.reload();
+
+    atomic<bool>          stop{false};
+    atomic<unsigned long> totalReads{0};
+    atomic<unsigned long> inconsistent{0};
+
+    vector<thread> threads;
+    for (unsigned i = 0; i < readers; i++) {
+        threads.emplace_back([&]() {
+            unsigned long count = 0;
+            unsigned long bad   = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                auto snapshot = reloader.read();
+                if (snapshot->get<int>("workers") != snapshot->get<int>("threads") * 2) { bad++; }
+                count++;
+            }
+            totalReads += count;
+            inconsistent += bad;
+        });
+    }
+
+    auto   start         = chrono::steady_clock::now();
+    double maxReloadUs   = 0;
+    double totalReloadUs = 0;
+    for (int i = 1; i <= reloads; i++) {
+        writeConfig(i);
+        auto reloadStart = chrono::steady_clock::now();
+        reloader.reload();
+        double us = chrono::duration<double, micro>(chrono::steady_clock::now() - reloadStart).count();
+        totalReloadUs += us;
+        if (us > maxReloadUs) { maxReloadUs = us; }
+    }
+    stop = true;
+    for (auto &t : threads) { t.join(); }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    printf("Readers            : %u\n", readers);
+    printf("Reloads            : %d\n", reloads);
+    printf("Reads              : %lu (%.1f M/s)\n", totalReads.load(), static_cast<double>(totalReads.load()) / seconds / 1e6);
+    printf("Reload avg / max   : %.1f us / %.1f us\n", totalReloadUs / reloads, maxReloadUs);
+    printf("Inconsistent reads : %lu\n", inconsistent.load());
+
+    return inconsistent.load() == 0 ? 0 : 1;
+}
@@ -5,6 +5,7 @@ import re
 import subprocess
 import argparse
 import glob
+import time
 from dataclasses import dataclass
 from typing import List, Tuple
 
@@ -26,6 +27,7 @@ class BenchmarkTarget:
     allocs: int = 0
     allocated_bytes: int = 0
     peak_heap_usage: float = 0.0
+    startup_time: float = 0.0
 
 def run_valgrind_massif(binary_path: str, run_args: List[str], name: str) -> float:
     """
@@ -112,7 +114,19 @@ def run_valgrind_memcheck(binary_path: str, run_args: List[str]) -> Tuple[int, i
         sys.exit(1)
 
 
-def run_benchmarks(targets: List[BenchmarkTarget], run_args: List[str]):
+def measure_startup_time(binary_path: str, run_args: List[str], runs: int) -> float:
+    """
+    Runs a binary several times without valgrind and measures its wall-clock time.
+    Returns the average time of a single run in milliseconds.
+    """
+    blue(f"Measuring startup time ({runs} runs): {binary_path}")
+    start = time.perf_counter()
+    for _ in range(runs):
+        subprocess.run([binary_path] + run_args, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL, check=False)
+    return (time.perf_counter() - start) / runs * 1000
+
+
+def run_benchmarks(targets: List[BenchmarkTarget], run_args: List[str], startup_runs: int):
     """Runs valgrind benchmarks for each target."""
     for target in targets:
         colored_print(f"=== Benchmarking Runtime for {target.name} ===", color="magenta")
@@ -125,6 +139,7 @@ def run_benchmarks(targets: List[BenchmarkTarget], run_args: List[str]):
 
         target.allocs, target.allocated_bytes = run_valgrind_memcheck(binary_path, run_args)
         target.peak_heap_usage = run_valgrind_massif(binary_path, run_args, target.binary_name)
+        target.startup_time = measure_startup_time(binary_path, run_args, startup_runs)
 
 
 def print_results(targets: List[BenchmarkTarget], baseline: BenchmarkTarget, no_baseline: bool):
@@ -133,24 +148,27 @@ def print_results(targets: List[BenchmarkTarget], baseline: BenchmarkTarget, no_
     if not no_baseline:
         print("NOTE: Baseline measurements have been subtracted.")
 
-    print("| Name         | Allocs | Allocated (KB) | Peak Heap (KB) |")
-    print("| ------------ | -----: | -------------: | -------------: |")
+    print("| Name         | Allocs | Allocated (KB) | Peak Heap (KB) | Startup (ms) |")
+    print("| ------------ | -----: | -------------: | -------------: | -----------: |")
 
     if not no_baseline:
         allocated_str = f"{(baseline.allocated_bytes/1024):.2f}"
         peak_str = f"{baseline.peak_heap_usage:.2f}"
-        print(f"| {baseline.name:<12} | {baseline.allocs:>6} | {allocated_str:>14} | {peak_str:>14} |")
+        startup_str = f"{baseline.startup_time:.3f}"
+        print(f"| {baseline.name:<12} | {baseline.allocs:>6} | {allocated_str:>14} | {peak_str:>14} | {startup_str:>12} |")
 
     for target in targets:
         allocs_val = target.allocs - baseline.allocs if not no_baseline else target.allocs
         allocated_val = target.allocated_bytes - baseline.allocated_bytes if not no_baseline else target.allocated_bytes
         peak_val = target.peak_heap_usage - baseline.peak_heap_usage if not no_baseline else target.peak_heap_usage
+        startup_val = target.startup_time - baseline.startup_time if not no_baseline else target.startup_time
 
         allocs_str = str(allocs_val)
         allocated_str = f"{allocated_val/1024:.2f}"
         peak_str = f"{peak_val:.2f}"
+        startup_str = f"{startup_val:.3f}"
 
-        print(f"| {target.name:<12} | {allocs_str:>6} | {allocated_str:>14} | {peak_str:>14} |")
+        print(f"| {target.name:<12} | {allocs_str:>6} | {allocated_str:>14} | {peak_str:>14} | {startup_str:>12} |")
 
 
 def main():
@@ -159,6 +177,7 @@ def main():
     parser.add_argument("-a", "--arg", dest="extra_args", action="append", default=[], help="Additional arguments to pass to the benchmarked binary (can be specified multiple times)")
     parser.add_argument("-b", "--no-baseline", action="store_true", help="Do not subtract baseline measurements from a 'hello world' program.")
     parser.add_argument("-n", "--num-infiles", type=int, help="Generate n infile arguments to test performance with many arguments.")
+    parser.add_argument("-s", "--startup-runs", type=int, default=100, help="Number of runs used to measure the startup time (default: 100)")
     args = parser.parse_args()
 
     COMMON_RUN_ARGS = ["-v", "-c", "123", "outfile", "infile1", "infile2"] + args.extra_args
@@ -178,17 +197,19 @@ def main():
         hello_world_bin, _, _ = compile_cpp(hello_world_src, compile_args= ["-s", "-O2"])
         baseline.allocs, baseline.allocated_bytes = run_valgrind_memcheck(hello_world_bin, [])
         baseline.peak_heap_usage = run_valgrind_massif(hello_world_bin, [], baseline.binary_name)
-        success(f"hello_world baseline: allocs={baseline.allocs}, allocated_bytes={baseline.allocated_bytes}, peak_heap={baseline.peak_heap_usage}KB")
+        baseline.startup_time = measure_startup_time(hello_world_bin, [], args.startup_runs)
+        success(f"hello_world baseline: allocs={baseline.allocs}, allocated_bytes={baseline.allocated_bytes}, peak_heap={baseline.peak_heap_usage}KB, startup={baseline.startup_time:.3f}ms")
 
     benchmark_targets = [
         BenchmarkTarget(name="ArgLite Mini", binary_name="minimal"),
         BenchmarkTarget(name="ArgLite Full", binary_name="full"),
+        BenchmarkTarget(name="ArgLite NoIO", binary_name="full_no_iostream"),
         BenchmarkTarget(name="CLI11",        binary_name="CLI11"),
         BenchmarkTarget(name="cxxopts",      binary_name="cxxopts"),
         BenchmarkTarget(name="args",         binary_name="args"),
         BenchmarkTarget(name="argparse",     binary_name="argparse"),
     ]
-    run_benchmarks(benchmark_targets, COMMON_RUN_ARGS)
+    run_benchmarks(benchmark_targets, COMMON_RUN_ARGS, args.startup_runs)
     print_results(benchmark_targets, baseline, args.no_baseline)
 
 if __name__ == "__main__":
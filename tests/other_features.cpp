@@ -14,13 +14,27 @@ int main(int argc, char **argv) {
     Parser::setShortNonFlagOptsStr("iIdn");
     Parser::preprocess(argc, argv);
 
+    // Expensive setup can be skipped when only the help message is needed
+    if (Parser::isHelpRequested()) { cout << "Help requested, setup skipped.\n"; }
+
     auto verbose   = Parser::countFlag("v,verbose", "Verbose output.");
     auto enableX   = Parser::hasMutualExFlag({"x,enable-x", "Enable feature x.", "X,disable-x", "Disable feature x.", false});
     auto indent    = Parser::get<int>("i,indent", "Option Description indent.").setDefault(26).setTypeName("num").get();
     auto userName  = Parser::get<string>("n,name", "Your name.").required().get();
     auto delimiter = Parser::get<char>("d,delimiter", "--include delimiter.").setDefault(':').get();
     auto include   = Parser::get<string>("I,include", "Include directory.").setDefault("include").getVec(delimiter);
-    auto optional  = Parser::get<std::optional<string>>("o,optional", "Optional argument.").get();
+    auto optDesc   = string("Optional argument.") + " Its description is not a literal.";
+    auto optional  = Parser::get<std::optional<string>>("o,optional", optDesc).get();
+
+    // Lazy defaults, the functions are only called if the options are not provided
+    int  jobsFnCalls = 0;
+    auto jobs        = Parser::get<int>("j,jobs", "Number of jobs.")
+                    .setDefaultFn([&jobsFnCalls] {
+                        jobsFnCalls++;
+                        return 4;
+                    }, "number of CPUs")
+                    .get();
+    auto level = Parser::get<int>("l,level", "Compression level.").setDefaultFn([] { return 6; }).get();
 
     Parser::changeDescriptionIndent(indent);
     Parser::runAllPostprocess();
@@ -34,6 +48,8 @@ int main(int argc, char **argv) {
         cout << "Optional   : " << *optional << '\n';
     else
         cout << "Optional   : (not set)\n";
+    cout << "Jobs       : " << jobs << " (default function calls: " << jobsFnCalls << ")\n";
+    cout << "Level      : " << level << '\n';
     cout << "Include:\n";
     for (const auto &it : include) { cout << "  " << it << '\n'; }
 
@@ -94,6 +94,21 @@ def main():
                    suffix="_minimal", extra_compile_args=["-DMINIMAL"]),
         TestTarget(source="test_get_pos.cpp", description="Test positional argument logic (Full)",
                    suffix="_full"),
+        TestTarget(source="test_output_sink.cpp", description="Test output sinks"),
+        TestTarget(source="test_no_iostream.cpp", description="Test iostream-free build mode"),
+        TestTarget(source="test_minimal_fixed.cpp", description="Test fixed-capacity minimal version"),
+        TestTarget(source="test_pmr.cpp", description="Test memory resource support"),
+        TestTarget(source="test_embedded.cpp", description="Test embedded mode"),
+        TestTarget(source="test_snapshot.cpp", description="Test parsed-arguments snapshots"),
+        TestTarget(source="test_env.cpp", description="Test environment variable fallback"),
+        TestTarget(source="test_config_file.cpp", description="Test config file layer"),
+        TestTarget(source="test_reload.cpp", description="Test config reloading", extra_compile_args=["-pthread"]),
+        TestTarget(source="test_cmdline.cpp", description="Test NUL-separated command line parsing", extra_compile_args=["-pthread"]),
+        TestTarget(source="test_argv_tail.cpp", description="Test stopping at the first positional argument"),
+        TestTarget(source="test_pass_through.cpp", description="Test passing unknown options through"),
+        TestTarget(source="test_permute.cpp", description="Test permuting argv in place"),
+        TestTarget(source="test_scoped.cpp", description="Test position-scoped options"),
+        TestTarget(source="test_map.cpp", description="Test key-value map options"),
     ]
 
     # --- Compilation Phase ---
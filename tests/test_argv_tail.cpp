@@ -0,0 +1,125 @@
+#include "ArgLite/Core.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using ArgLite::OutputSink;
+using ArgLite::Parser;
+using Status = Parser::ParseStatus;
+
+string out;
+string err;
+
+// Helper function to create argv, terminated by a null pointer like the argv of main()
+vector<char *> create_argv(const vector<string> &args) {
+    vector<char *> argv;
+    for (const auto &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+    return argv;
+}
+
+struct Wrapper {
+    bool   verbose;
+    int    timeout;
+    string signal;
+    string user;
+};
+
+Status parse(const vector<string> &args, Wrapper &cfg, vector<string> &tail) {
+    out.clear();
+    err.clear();
+    auto argv = create_argv(args);
+    Parser::preprocess(static_cast<int>(args.size()), argv.data());
+
+    cfg.verbose = Parser::hasFlag("v,verbose", "Verbose output.");
+    cfg.timeout = Parser::get<int>("t,timeout", "Timeout in seconds.").setDefault(0).get();
+    cfg.signal  = Parser::get<string>("s,signal", "Signal to send.").setDefault("TERM").get();
+    cfg.user    = Parser::get<string>("user", "User to run as.").setDefault("root").get();
+
+    auto argvTail = Parser::getArgvTail();
+    tail.assign(argvTail.begin(), argvTail.end());
+    if (!argvTail.empty()) {
+        // Ends with the null pointer of argv, ready for execvp
+        assert(argvTail.data[argvTail.size] == nullptr);
+        assert(argvTail.data == argv.data() + (args.size() - argvTail.size));
+    }
+
+    return Parser::postprocess();
+}
+
+void testStopAtFirstPositional() {
+    cerr << "--- Testing stopping at the first positional argument ---\n";
+    Wrapper        cfg{};
+    vector<string> tail;
+
+    // Options of the wrapped command stay in the tail
+    assert(parse({"./wrap", "-v", "-t", "5", "ls", "-la", "--color=auto", "dir"}, cfg, tail) == Status::Ok);
+    assert(cfg.verbose);
+    assert(cfg.timeout == 5);
+    assert((tail == vector<string>{"ls", "-la", "--color=auto", "dir"}));
+
+    // A flag never takes the command as its value
+    assert(parse({"./wrap", "--verbose", "make", "-j8"}, cfg, tail) == Status::Ok);
+    assert(cfg.verbose);
+    assert((tail == vector<string>{"make", "-j8"}));
+
+    // Long options with a value, in both forms
+    assert(parse({"./wrap", "--signal", "KILL", "--user=ada", "-t3", "sleep", "10"}, cfg, tail) == Status::Ok);
+    assert(cfg.signal == "KILL");
+    assert(cfg.user == "ada");
+    assert(cfg.timeout == 3);
+    assert((tail == vector<string>{"sleep", "10"}));
+
+    // The tail starts after `--`, and `-h` in it is not a help request
+    assert(parse({"./wrap", "-vs", "INT", "--", "-h", "--", "x"}, cfg, tail) == Status::Ok);
+    assert(cfg.signal == "INT");
+    assert((tail == vector<string>{"-h", "--", "x"}));
+
+    // No tail
+    assert(parse({"./wrap", "-v"}, cfg, tail) == Status::Ok);
+    assert(tail.empty());
+    assert(parse({"./wrap", "-v", "--"}, cfg, tail) == Status::Ok);
+    assert(tail.empty());
+
+    // Unknown options before the tail are still reported
+    assert(parse({"./wrap", "--unknown", "ls"}, cfg, tail) == Status::Error);
+    assert(err.find("--unknown") != string::npos);
+    assert((tail == vector<string>{"ls"}));
+
+    cerr << "Stopping at the first positional argument PASSED\n"
+         << '\n';
+}
+
+void testDisabled() {
+    cerr << "--- Testing parsing all arguments ---\n";
+    Wrapper        cfg{};
+    vector<string> tail;
+
+    Parser::setStopAtFirstPositional(false);
+    assert(parse({"./wrap", "ls", "-v"}, cfg, tail) == Status::Ok);
+    assert(cfg.verbose);
+    assert(tail.empty());
+    Parser::setStopAtFirstPositional();
+
+    cerr << "Parsing all arguments PASSED\n"
+         << '\n';
+}
+
+int main() {
+    Parser::setEmbeddedMode();
+    Parser::setOutput(OutputSink::string(out), OutputSink::string(err));
+    Parser::setShortNonFlagOptsStr("ts");
+    Parser::setLongNonFlagOpts({"timeout", "signal", "user"});
+    Parser::setStopAtFirstPositional();
+
+    testStopAtFirstPositional();
+    testDisabled();
+
+    cerr << "All tests passed!\n";
+
+    return 0;
+}
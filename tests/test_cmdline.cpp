@@ -0,0 +1,106 @@
+#include "ArgLite/Cmdline.hpp"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unistd.h>
+
+using namespace std;
+using namespace std::string_view_literals;
+using ArgLite::CmdlineSchema;
+using ArgLite::CmdlineView;
+
+struct Handles {
+    uint32_t verbose;
+    uint32_t all;
+    uint32_t threads;
+    uint32_t name;
+    uint32_t define;
+};
+
+CmdlineSchema makeSchema(Handles &h) {
+    CmdlineSchema schema;
+    h.verbose = schema.addFlag("v,verbose");
+    h.all     = schema.addFlag("a");
+    h.threads = schema.addOption("t,threads");
+    h.name    = schema.addOption("name");
+    h.define  = schema.addOption("D");
+    return schema;
+}
+
+void testParseBuffer() {
+    cerr << "--- Testing NUL-separated buffers ---\n";
+    Handles h{};
+    auto    schema = makeSchema(h);
+
+    // The format of /proc/<pid>/cmdline, with a trailing NUL
+    string buffer("/usr/bin/server\0-vv\0--threads\0008\0-Dx=1\0-D\0y=2\0--name=Ada\0in.txt\0--\0-a\0"sv);
+    CmdlineView view;
+    assert(view.parse(schema, buffer));
+
+    assert(view.program() == "/usr/bin/server");
+    assert(view.args().size() == 11);
+    assert(view.count(h.verbose) == 2);
+    assert(view.count(h.all) == 0);
+    assert(view.get<int>(h.threads) == 8);
+    assert(view.value(h.name) == "Ada");
+    assert(view.count(h.define) == 2);
+    vector<string_view> defines;
+    view.forEachValue(h.define, [&](string_view value) { defines.push_back(value); });
+    assert((defines == vector<string_view>{"x=1", "y=2"}));
+    assert((view.positionals() == vector<string_view>{"in.txt", "-a"}));
+
+    // Values are views of the buffer
+    assert(view.value(h.name).data() >= buffer.data() && view.value(h.name).data() < buffer.data() + buffer.size());
+
+    // The view is reused for the next command line
+    string other("server\0-av\0-t3\0--unknown\0-x\0--name\0"sv);
+    assert(!view.parse(schema, other));
+    assert(view.count(h.verbose) == 1);
+    assert(view.count(h.all) == 1);
+    assert(view.get<int>(h.threads) == 3);
+    assert((view.unknownOptions() == vector<string_view>{"--unknown", "-x"}));
+    assert((view.missingValues() == vector<uint32_t>{h.name}));
+    assert(view.value(h.name, "nobody") == "nobody");
+    assert(view.positionals().empty());
+
+    // Without a trailing NUL, or empty
+    assert(view.parse(schema, "prog\0-t\0abc"sv));
+    assert(view.value(h.threads) == "abc");
+    assert(view.get<int>(h.threads, -1) == -1);
+    assert(view.parse(schema, string_view()));
+    assert(view.program().empty());
+
+    cerr << "NUL-separated buffers PASSED\n"
+         << '\n';
+}
+
+void testScanProc() {
+    cerr << "--- Testing scanning /proc ---\n";
+    Handles h{};
+    auto    schema = makeSchema(h);
+
+    atomic<bool> foundSelf{false};
+    auto         parsed = ArgLite::scanProcCmdlines(schema, [&](int pid, const CmdlineView &view) {
+        if (pid == getpid()) {
+            foundSelf = string_view(view.program()).find("test_cmdline") != string_view::npos;
+        }
+    }, 4);
+
+    assert(parsed > 0);
+    assert(foundSelf);
+
+    cerr << "Scanning /proc PASSED\n"
+         << '\n';
+}
+
+int main() {
+    testParseBuffer();
+    testScanProc();
+
+    cerr << "All tests passed!\n";
+
+    return 0;
+}
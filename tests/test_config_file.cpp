@@ -0,0 +1,172 @@
+#define ARGLITE_ENABLE_CONFIG_FILE
+
+#include "ArgLite/Core.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using ArgLite::OutputSink;
+using ArgLite::Parser;
+using ArgLite::SubParser;
+using Status = Parser::ParseStatus;
+
+string out;
+string err;
+
+// Helper function to create argv
+vector<char *> create_argv(const vector<string> &args) {
+    vector<char *> argv;
+    for (const auto &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    return argv;
+}
+
+string writeFile(const string &name, const string &content) {
+    string path = "/tmp/arglite_" + name;
+    FILE  *file = fopen(path.c_str(), "wb");
+    assert(file != nullptr);
+    fwrite(content.data(), 1, content.size(), file);
+    fclose(file);
+    return path;
+}
+
+SubParser serve("serve", "Start the server.");
+
+struct Config {
+    int         threads;
+    string      name;
+    vector<int> ids;
+    int         level;
+    int         port;
+    string      host;
+};
+
+Status parse(const vector<string> &args, Config &cfg) {
+    out.clear();
+    err.clear();
+    auto argv = create_argv(args);
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+
+    cfg.threads = Parser::get<int>("t,threads", "Number of threads.").setDefault(1).get();
+    cfg.name    = Parser::get<string>("n,name", "Name.").setDefault("nobody").get();
+    cfg.ids     = Parser::get<int>("i,ids", "Identifiers.").getVec(',');
+    cfg.level   = Parser::get<int>("l,level", "Level.").setDefault(7).get();
+    cfg.port    = serve.get<int>("p,port", "Port.").setDefault(80).get();
+    cfg.host    = serve.get<string>("host", "Host.").setDefault("localhost").get();
+
+    return Parser::postprocess();
+}
+
+void testConfigValues() {
+    cerr << "--- Testing config file values ---\n";
+    auto path = writeFile("config.ini",
+                          "# Main command\n"
+                          "threads = 4\n"
+                          "name = \"Ada Lovelace\"\r\n"
+                          "ids=1,2,3\n"
+                          "threads = 6\n"
+                          "\n"
+                          "[serve]\n"
+                          "  port = 8080\n"
+                          "host = example.com\n"
+                          "level = 3\n");
+    assert(Parser::loadConfigFile(path));
+    Config cfg{};
+
+    assert(parse({"./config"}, cfg) == Status::Ok);
+    assert(cfg.threads == 6); // The last one wins
+    assert(cfg.name == "Ada Lovelace");
+    assert((cfg.ids == vector<int>{1, 2, 3}));
+    assert(cfg.level == 7); // Only in the section of the subcommand
+    assert(err.empty());
+
+    // The command line wins over the config file
+    assert(parse({"./config", "-t", "2", "--name=Bob"}, cfg) == Status::Ok);
+    assert(cfg.threads == 2);
+    assert(cfg.name == "Bob");
+    assert((cfg.ids == vector<int>{1, 2, 3}));
+
+    // Subcommands use their own section
+    assert(parse({"./config", "serve"}, cfg) == Status::Ok);
+    assert(cfg.port == 8080);
+    assert(cfg.host == "example.com");
+    assert(parse({"./config", "serve", "--port", "9000"}, cfg) == Status::Ok);
+    assert(cfg.port == 9000);
+
+    // The environment variable wins over the config file
+    setenv("APP_THREADS", "12", 1);
+    Parser::setEnvPrefix("APP_");
+    assert(parse({"./config"}, cfg) == Status::Ok);
+    assert(cfg.threads == 12);
+    Parser::setEnvPrefix("");
+
+    Parser::closeConfigFile();
+    assert(parse({"./config"}, cfg) == Status::Ok);
+    assert(cfg.threads == 1);
+    assert(cfg.name == "nobody");
+
+    cerr << "Config file values PASSED\n"
+         << '\n';
+}
+
+void testErrorsAndMissingFile() {
+    cerr << "--- Testing config file errors ---\n";
+    assert(!Parser::loadConfigFile("/tmp/arglite_missing.ini"));
+
+    auto path = writeFile("invalid.ini", "threads = many\nids = 1,x\n");
+    assert(Parser::loadConfigFile(path));
+    Config cfg{};
+    assert(parse({"./config"}, cfg) == Status::Error);
+    assert(cfg.threads == 1);
+    assert((cfg.ids == vector<int>{1}));
+    assert(err.find("Invalid value for key 'threads' in the config file '" + path +
+                    "' of option '-t, --threads'. Expected a integer, but got 'many'.") != string::npos);
+    assert(err.find("Invalid value for key 'ids'") != string::npos);
+
+    // An empty file is valid
+    path = writeFile("empty.ini", "");
+    assert(Parser::loadConfigFile(path));
+    assert(parse({"./config"}, cfg) == Status::Ok);
+    assert(cfg.threads == 1);
+
+    cerr << "Config file errors PASSED\n"
+         << '\n';
+}
+
+void testLargeFile() {
+    cerr << "--- Testing a large config file ---\n";
+    string content;
+    for (int i = 0; i < 10000; i++) {
+        content += "key" + to_string(i) + " = " + to_string(i) + "\n";
+    }
+    content += "level = 9\n";
+    auto path = writeFile("large.ini", content);
+    assert(Parser::loadConfigFile(path));
+
+    Config cfg{};
+    assert(parse({"./config"}, cfg) == Status::Ok);
+    assert(cfg.level == 9);
+    assert(cfg.threads == 1);
+    Parser::closeConfigFile();
+
+    cerr << "Large config file PASSED\n"
+         << '\n';
+}
+
+int main() {
+    Parser::setEmbeddedMode();
+    Parser::setOutput(OutputSink::string(out), OutputSink::string(err));
+
+    testConfigValues();
+    testErrorsAndMissingFile();
+    testLargeFile();
+
+    cerr << "All tests passed!\n";
+
+    return 0;
+}
@@ -0,0 +1,181 @@
+#include "ArgLite/Core.hpp"
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using ArgLite::OutputSink;
+using ArgLite::Parser;
+using ArgLite::SubParser;
+using Status = Parser::ParseStatus;
+
+string out;
+string err;
+
+// Helper function to create argv
+vector<char *> create_argv(const vector<string> &args) {
+    vector<char *> argv;
+    for (const auto &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    return argv;
+}
+
+struct Command {
+    bool   verbose;
+    int    count;
+    string input;
+};
+
+// Parses one command line like a server handling a request
+Status runCommand(const vector<string> &args, Command &cmd) {
+    out.clear();
+    err.clear();
+    auto argv = create_argv(args);
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+
+    cmd.verbose = Parser::hasFlag("v,verbose", "Verbose output.");
+    cmd.count   = Parser::get<int>("c,count", "Counter.").setDefault(3).get();
+    cmd.input   = Parser::getPositional("input", "Input file.");
+
+    return Parser::postprocess();
+}
+
+void testStatuses() {
+    cerr << "--- Testing statuses of the embedded mode ---\n";
+    Command cmd{};
+
+    assert(runCommand({"admin", "-v", "-c", "5", "file"}, cmd) == Status::Ok);
+    assert(cmd.verbose && cmd.count == 5 && cmd.input == "file");
+    assert(out.empty() && err.empty());
+
+    assert(runCommand({"admin", "--help"}, cmd) == Status::HelpPrinted);
+    assert(out.find("Usage: admin [OPTIONS] input") != string::npos);
+    assert(out.find("  -c, --count <integer>  Counter. [default: 3]") != string::npos);
+    assert(err.empty());
+
+    assert(runCommand({"admin", "-V"}, cmd) == Status::VersionPrinted);
+    assert(out == "admin 1.0\n");
+
+    assert(runCommand({"admin", "-c", "abc", "--unknown"}, cmd) == Status::Error);
+    assert(cmd.count == 3);
+    assert(err.find("Unrecognized option '--unknown'") != string::npos);
+    assert(err.find("Invalid value for option '-c, --count'") != string::npos);
+    assert(err.find("Missing required positional argument 'input'.") != string::npos);
+
+    // Nothing is left from the previous command lines
+    assert(runCommand({"admin", "other"}, cmd) == Status::Ok);
+    assert(!cmd.verbose && cmd.count == 3 && cmd.input == "other");
+    assert(out.empty() && err.empty());
+
+    // The help message is the same after the containers are reused
+    assert(runCommand({"admin", "-h"}, cmd) == Status::HelpPrinted);
+    auto firstHelp = out;
+    assert(runCommand({"admin", "-h"}, cmd) == Status::HelpPrinted);
+    assert(out == firstHelp);
+
+    cerr << "Statuses of the embedded mode PASSED\n"
+         << '\n';
+}
+
+void testMisuseReported() {
+    cerr << "--- Testing misuses reported as errors ---\n";
+    vector<string> args = {"admin"};
+    auto           argv = create_argv(args);
+    err.clear();
+
+    // A duplicate subcommand is not registered, they are registered for the rest of the program
+    static SubParser first("sub", "A subcommand.");
+    static SubParser second("sub", "The same subcommand.");
+    assert(err.find("This subcommand name is already used: sub") != string::npos);
+
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+    auto flag = Parser::hasFlag("", "Empty name.");
+    assert(!flag);
+    assert(Parser::postprocess() == Status::Error);
+    assert(err.find("Option name in hasFlag/get* functions cannot be empty.") != string::npos);
+
+    cerr << "Misuses reported as errors PASSED\n"
+         << '\n';
+}
+
+// The buffer is gone when the help is rendered
+int declareWithBuffer() {
+    char description[32];
+    snprintf(description, sizeof(description), "Threads (max %d).", 8);
+    return Parser::get<int>("t,threads", description).setDefault(1).get();
+}
+
+void testBufferDescriptions() {
+    cerr << "--- Testing descriptions in writable buffers ---\n";
+    vector<string> args = {"admin", "-h"};
+    auto           argv = create_argv(args);
+    out.clear();
+
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+    declareWithBuffer();
+    assert(Parser::postprocess() == Status::HelpPrinted);
+    // Copied up to the null character, without the rest of the buffer
+    assert(out.find("Threads (max 8).") != string::npos);
+    assert(out.find('\0') == string::npos);
+
+    cerr << "Descriptions in writable buffers PASSED\n"
+         << '\n';
+}
+
+// A program with its own -h option
+Status runHost(const vector<string> &args, string &host, string &file) {
+    out.clear();
+    err.clear();
+    auto argv = create_argv(args);
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+
+    auto count = Parser::get<int>("c,count", "Counter.").setDefault(3).get();
+    host = Parser::get<string>("h,host", "Host name.").setDefault("localhost").get();
+    file = Parser::getPositional("file", "Input file.", false);
+    assert(count == 3);
+
+    return Parser::postprocess();
+}
+
+void testHelpOptionTaken() {
+    cerr << "--- Testing a declared -h option ---\n";
+    string host;
+    string file;
+    Parser::setShortNonFlagOptsStr("ch");
+
+    assert(runHost({"admin", "-h", "example.com", "f.txt"}, host, file) == Status::Ok);
+    assert(host == "example.com" && file == "f.txt");
+    assert(out.empty());
+
+    // An error found before the option is got is still reported
+    assert(runHost({"admin", "-c", "abc", "-h", "example.com"}, host, file) == Status::Error);
+    assert(err.find("abc") != string::npos);
+
+    // --help is still a help request, and -h is only listed once
+    assert(runHost({"admin", "-h", "example.com", "--help"}, host, file) == Status::HelpPrinted);
+    assert(out.find("  -h, --host <string>") != string::npos);
+    assert(out.find("      --help") != string::npos);
+    assert(out.find("-h, --help") == string::npos);
+
+    Parser::setShortNonFlagOptsStr("");
+    cerr << "Declared -h option PASSED\n"
+         << '\n';
+}
+
+int main() {
+    Parser::setEmbeddedMode();
+    Parser::setOutput(OutputSink::string(out), OutputSink::string(err));
+    Parser::setVersion("admin 1.0");
+
+    testStatuses();
+    testBufferDescriptions();
+    testHelpOptionTaken();
+    testMisuseReported();
+
+    cerr << "All tests passed!\n";
+
+    return 0;
+}
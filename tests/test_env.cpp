@@ -0,0 +1,132 @@
+#include "ArgLite/Core.hpp"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using ArgLite::OutputSink;
+using ArgLite::Parser;
+using Status = Parser::ParseStatus;
+
+string out;
+string err;
+
+// Helper function to create argv
+vector<char *> create_argv(const vector<string> &args) {
+    vector<char *> argv;
+    for (const auto &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    return argv;
+}
+
+struct Config {
+    int         threads;
+    int         maxSize;
+    int         level;
+    vector<int> ids;
+    string      name;
+    string      token;
+};
+
+Status parse(const vector<string> &args, Config &cfg) {
+    out.clear();
+    err.clear();
+    auto argv = create_argv(args);
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+
+    cfg.threads = Parser::get<int>("t,threads", "Number of threads.").setDefault(1).get();
+    cfg.maxSize = Parser::get<int>("max-size", "Maximum size.").setDefault(16).get();
+    cfg.level   = Parser::get<int>("l,level", "Level.").setDefault(7).get();
+    cfg.ids     = Parser::get<int>("i,ids", "Identifiers.").getVec(',');
+    cfg.name    = Parser::get<string>("n,name", "Name.").env("CUSTOM_NAME").get();
+    cfg.token   = Parser::get<string>("token", "Access token.").required().get();
+
+    return Parser::postprocess();
+}
+
+void testPrecedence() {
+    cerr << "--- Testing the precedence of environment variables ---\n";
+    Config cfg{};
+
+    assert(parse({"./env"}, cfg) == Status::Ok);
+    assert(cfg.threads == 8);
+    assert(cfg.maxSize == 64);
+    assert(cfg.level == 7);
+    assert((cfg.ids == vector<int>{1, 2, 3}));
+    assert(cfg.name == "Ada");
+    assert(cfg.token == "secret");
+    assert(err.empty());
+
+    // The command line wins over the environment
+    assert(parse({"./env", "-t", "2", "--max-size=5", "-i", "9", "--name", "Bob", "--token", "cli"}, cfg) == Status::Ok);
+    assert(cfg.threads == 2);
+    assert(cfg.maxSize == 5);
+    assert((cfg.ids == vector<int>{9}));
+    assert(cfg.name == "Bob");
+    assert(cfg.token == "cli");
+
+    cerr << "Precedence of environment variables PASSED\n"
+         << '\n';
+}
+
+void testHelpAndErrors() {
+    cerr << "--- Testing help and errors of environment variables ---\n";
+    Config cfg{};
+
+    assert(parse({"./env", "-h"}, cfg) == Status::HelpPrinted);
+    assert(out.find("  -l, --level <integer>  Level. [default: 7] [env: APP_LEVEL]\n") != string::npos);
+    assert(out.find("Maximum size. [default: 16] [env: APP_MAX_SIZE]") != string::npos);
+    assert(out.find("Name. [env: CUSTOM_NAME]") != string::npos);
+
+    setenv("APP_LEVEL", "high", 1);
+    unsetenv("APP_TOKEN");
+    // The environment is indexed again when the prefix is set
+    Parser::setEnvPrefix("APP_");
+    assert(parse({"./env"}, cfg) == Status::Error);
+    assert(cfg.level == 7);
+    assert(err.find("Invalid value for environment variable 'APP_LEVEL' of option '-l, --level'. "
+                    "Expected a integer, but got 'high'.") != string::npos);
+    assert(err.find("Option '--token' is required") != string::npos);
+
+    cerr << "Help and errors of environment variables PASSED\n"
+         << '\n';
+}
+
+void testNoPrefix() {
+    cerr << "--- Testing environment variables without a prefix ---\n";
+    Config cfg{};
+
+    Parser::setEnvPrefix("");
+    assert(parse({"./env", "--token", "t"}, cfg) == Status::Ok);
+    assert(cfg.threads == 1);
+    assert(cfg.maxSize == 16);
+    assert(cfg.ids.empty());
+    // An explicit name is still used
+    assert(cfg.name == "Ada");
+
+    cerr << "Environment variables without a prefix PASSED\n"
+         << '\n';
+}
+
+int main() {
+    setenv("APP_THREADS", "8", 1);
+    setenv("APP_MAX_SIZE", "64", 1);
+    setenv("APP_IDS", "1,2,3", 1);
+    setenv("APP_TOKEN", "secret", 1);
+    setenv("CUSTOM_NAME", "Ada", 1);
+
+    Parser::setEmbeddedMode();
+    Parser::setOutput(OutputSink::string(out), OutputSink::string(err));
+    Parser::setEnvPrefix("APP_");
+
+    testPrecedence();
+    testHelpAndErrors();
+    testNoPrefix();
+
+    cerr << "All tests passed!\n";
+
+    return 0;
+}
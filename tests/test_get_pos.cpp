@@ -212,6 +212,64 @@ void testMissingRequiredPositional() {
          << '\n';
 }
 
+#ifndef MINIMAL
+void testTypedPositionals() {
+    cerr << "--- Testing typed positionals ---\n";
+    // Test case 1: Values are converted to the requested types
+    {
+        vector<string> args = {"./getPosFull", "42", "0.5", "1", "--", "-2", "3"};
+        auto           argv = create_argv(args);
+        Parser::preprocess(argv.size(), argv.data());
+
+        auto count  = Parser::getPositional<int>("count", "Count.");
+        auto ratio  = Parser::getPositional<double>("ratio", "Ratio.");
+        auto flag   = Parser::getPositional<bool>("flag", "Flag.", false, false);
+        auto values = Parser::getRemainingPositionals<long>("values", "Values.");
+
+        assert(!Parser::runAllPostprocess(true));
+        assert(count == 42);
+        assert(ratio == 0.5);
+        assert(flag);
+        assert(values.size() == 2);
+        assert(values[0] == -2);
+        assert(values[1] == 3);
+    }
+    // Test case 2: Defaults are used when the typed positionals are not provided
+    {
+        vector<string> args = {"./getPosFull"};
+        auto           argv = create_argv(args);
+        Parser::preprocess(argv.size(), argv.data());
+
+        auto count  = Parser::getPositional<int>("count", "Count.", false, 7);
+        auto values = Parser::getRemainingPositionals<int>("values", "Values.", false, {1, 2});
+
+        assert(!Parser::runAllPostprocess(true));
+        assert(count == 7);
+        assert(values == vector<int>({1, 2}));
+    }
+
+    cerr << "Typed positionals PASSED\n"
+         << '\n';
+}
+
+void testInvalidTypedPositional() {
+    cerr << "--- Testing invalid typed positional ---\n";
+    vector<string> args = {"./getPosFull", "abc", "1", "x", "--", "-1"};
+    auto           argv = create_argv(args);
+    Parser::preprocess(argv.size(), argv.data());
+
+    auto count  = Parser::getPositional<int>("count", "Count.");
+    auto values = Parser::getRemainingPositionals<unsigned>("values", "Values.");
+    (void)count;
+    (void)values;
+
+    assert(Parser::runAllPostprocess(true)); // Expect error
+
+    cerr << "Invalid typed positional PASSED\n"
+         << '\n';
+}
+#endif
+
 int main() {
     cout << "Testing " VERSION " version" << '\n'
          << '\n';
@@ -223,6 +281,10 @@ int main() {
     testMixedPositionals();
     testMixedRemainingPositionals();
     testMissingRequiredPositional();
+#ifndef MINIMAL
+    testTypedPositionals();
+    testInvalidTypedPositional();
+#endif
 
     cerr << "All tests passed!\n";
 
@@ -0,0 +1,119 @@
+#include "ArgLite/Core.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using ArgLite::OutputSink;
+using ArgLite::Parser;
+using Policy = Parser::DuplicateKeyPolicy;
+using Status = Parser::ParseStatus;
+
+string out;
+string err;
+
+// Helper function to create argv
+vector<char *> create_argv(const vector<string> &args) {
+    vector<char *> argv;
+    for (const auto &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    return argv;
+}
+
+void testFlatMap() {
+    cerr << "--- Testing flat maps ---\n";
+    vector<string> args = {"./cc", "-DNDEBUG=1", "-D", "LEVEL=3", "--set", "a.b=c=d", "-DLEVEL=2", "--set=x=", "-DEMPTY="};
+    auto           argv = create_argv(args);
+
+    out.clear();
+    err.clear();
+    Parser::setShortNonFlagOptsStr("D");
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+    auto defines  = Parser::get<string>("D", "Macro definitions.").getMap();
+    auto settings = Parser::get<string>("set", "Settings.").getMap<string_view, string_view>();
+    assert(Parser::postprocess() == Status::Ok);
+
+    // Sorted by key, the last value wins
+    assert((defines == vector<pair<string, string>>{{"EMPTY", ""}, {"LEVEL", "2"}, {"NDEBUG", "1"}}));
+    // Split on the first `=`, and the views point into argv
+    assert((settings == vector<pair<string_view, string_view>>{{"a.b", "c=d"}, {"x", ""}}));
+    assert(settings[0].first.data() == argv[5]);
+
+    cerr << "Flat maps PASSED\n"
+         << '\n';
+}
+
+void testTypedAndHashMap() {
+    cerr << "--- Testing typed keys and hash maps ---\n";
+    vector<string> args = {"./tool", "--weight", "3=0.5", "--weight", "1=2", "--limit", "cpu=4", "--limit", "mem=8", "--limit", "cpu=2"};
+    auto           argv = create_argv(args);
+
+    out.clear();
+    err.clear();
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+    auto weights = Parser::get<double>("weight", "Weights.").getMap<int>();
+    auto limits  = Parser::get<int>("limit", "Limits.").getUnorderedMap();
+    assert(Parser::postprocess() == Status::Ok);
+
+    assert((weights == vector<pair<int, double>>{{1, 2.0}, {3, 0.5}}));
+    assert((limits == unordered_map<string, int>{{"cpu", 2}, {"mem", 8}}));
+
+    cerr << "Typed keys and hash maps PASSED\n"
+         << '\n';
+}
+
+void testErrors() {
+    cerr << "--- Testing map errors ---\n";
+    vector<string> args = {"./tool", "--limit", "cpu=4", "--limit", "noequals", "--limit", "mem=lots",
+                           "--weight", "x=1", "--limit", "cpu=2", "--tag", "a=1", "--tag", "a=2"};
+    auto           argv = create_argv(args);
+
+    out.clear();
+    err.clear();
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+    auto limits  = Parser::get<int>("limit", "Limits.").getMap(Policy::Error);
+    auto weights = Parser::get<double>("weight", "Weights.").getMap<int>();
+    auto tags    = Parser::get<string>("tag", "Tags.").getUnorderedMap(Policy::Error);
+    auto names   = Parser::get<string>("name", "Names.").required().getMap();
+
+    // The duplicate is reported at the later occurrence
+    bool found = false;
+    for (const auto &error : Parser::getErrors()) {
+        if (error.code == Parser::ErrorCode::DuplicateKey && error.value == "cpu") { found = error.argvIndex == 10; }
+    }
+    assert(found);
+    assert(Parser::postprocess() == Status::Error);
+
+    assert((limits == vector<pair<string, int>>{{"cpu", 2}}));
+    assert(weights.empty());
+    assert((tags == unordered_map<string, string>{{"a", "2"}}));
+    assert(names.empty());
+
+    assert(err.find("Expected a key=value, but got 'noequals'") != string::npos);
+    assert(err.find("Expected a integer, but got 'lots'") != string::npos);
+    assert(err.find("Expected a integer, but got 'x'") != string::npos);
+    assert(err.find("Duplicate key 'cpu' for option '--limit'.") != string::npos);
+    assert(err.find("Duplicate key 'a' for option '--tag'.") != string::npos);
+    assert(err.find("--name") != string::npos);
+
+    cerr << "Map errors PASSED\n"
+         << '\n';
+}
+
+int main() {
+    Parser::setEmbeddedMode();
+    Parser::setOutput(OutputSink::string(out), OutputSink::string(err));
+
+    testFlatMap();
+    testTypedAndHashMap();
+    testErrors();
+
+    cerr << "All tests passed!\n";
+
+    return 0;
+}
@@ -0,0 +1,234 @@
+#define ARGLITE_ENABLE_FORMATTER
+
+#include "ArgLite/MinimalFixed.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+using ArgLite::OutputSink;
+
+using Parser = ArgLite::FixedParser<16, 4, 32>;
+
+// Count heap allocations, the parser must not make any
+size_t allocCount = 0;
+
+void *operator new(size_t size) {
+    allocCount++;
+    if (void *ptr = malloc(size)) { return ptr; }
+    throw bad_alloc();
+}
+void *operator new[](size_t size) { return operator new(size); }
+void  operator delete(void *ptr) noexcept { free(ptr); }
+void  operator delete[](void *ptr) noexcept { free(ptr); }
+void  operator delete(void *ptr, size_t) noexcept { free(ptr); }
+void  operator delete[](void *ptr, size_t) noexcept { free(ptr); }
+
+char   outBuf[4096];
+size_t outSize = 0;
+char   errBuf[4096];
+size_t errSize = 0;
+
+// Helper function to create argv
+vector<char *> create_argv(const vector<string> &args) {
+    vector<char *> argv;
+    for (const auto &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    return argv;
+}
+
+void resetOutput() {
+    outSize = 0;
+    errSize = 0;
+    Parser::setOutput(OutputSink::buffer(outBuf, sizeof(outBuf), &outSize),
+                      OutputSink::buffer(errBuf, sizeof(errBuf), &errSize));
+}
+
+void testParseWithoutHeap() {
+    fprintf(stderr, "--- Testing parsing without heap allocations ---\n");
+    resetOutput();
+    vector<string> args = {"./fixed", "-vx", "--count", "42", "-r2.5", "--name=Ada", "-e", "YES", "in", "a", "b"};
+    auto           argv = create_argv(args);
+
+    auto allocsBefore = allocCount;
+    Parser::setShortNonFlagOptsStr("r");
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+
+    auto verbose = Parser::hasFlag("v,verbose", "Verbose output.");
+    auto enableX = Parser::hasMutualExFlag({"x,enable-x", "Enable x.", "X,disable-x", "Disable x.", false});
+    auto count   = Parser::getInt("c,count", "Counter.", 3);
+    auto rate    = Parser::getDouble("r,rate", "Rate.");
+    auto name    = Parser::getString("n,name", "Name.", "nobody");
+    auto enable  = Parser::getBool("e,enable", "Enable.");
+    auto level   = Parser::getInt("l,level", "Level.", 7);
+    auto input   = Parser::getPositional("input", "Input file.");
+    auto extra   = Parser::getRemainingPositionals("extra", "Extra files.");
+
+    assert(!Parser::runAllPostprocess(true));
+    assert(allocCount == allocsBefore);
+
+    assert(verbose);
+    assert(enableX);
+    assert(count == 42);
+    assert(rate == 2.5);
+    assert(name == "Ada");
+    assert(enable);
+    assert(level == 7);
+    assert(input == "in");
+    assert(extra.size() == 2);
+    assert(extra[0] == "a");
+    assert(extra[1] == "b");
+    assert(errSize == 0);
+
+    fprintf(stderr, "Parsing without heap allocations PASSED\n\n");
+}
+
+void testErrorsWithoutHeap() {
+    fprintf(stderr, "--- Testing errors without heap allocations ---\n");
+    resetOutput();
+    vector<string> args = {"./fixed", "--count", "abc", "-u", "--name"};
+    auto           argv = create_argv(args);
+
+    auto allocsBefore = allocCount;
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+
+    auto count = Parser::getInt("c,count", "Counter.", 3);
+    auto name  = Parser::getString("n,name", "Name.");
+    auto input = Parser::getPositional("input", "Input file.");
+
+    assert(Parser::runAllPostprocess(true));
+    assert(allocCount == allocsBefore);
+
+    assert(count == 3);
+    assert(name.empty());
+    assert(input.empty());
+    string_view err(errBuf, errSize);
+    assert(err.find("Unrecognized option '-u'") != string_view::npos);
+    assert(err.find("Invalid value for option '-c, --count'. Expected a integer, but got 'abc'.") != string_view::npos);
+    assert(err.find("Option '-n, --name' requires a value.") != string_view::npos);
+    assert(err.find("Missing required positional argument 'input'.") != string_view::npos);
+
+    fprintf(stderr, "Errors without heap allocations PASSED\n\n");
+}
+
+void testTooManyArgs() {
+    fprintf(stderr, "--- Testing too many arguments ---\n");
+    resetOutput();
+    vector<string> args(40, "pos");
+    auto           argv = create_argv(args);
+
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+    auto all = Parser::getRemainingPositionals("all", "All arguments.");
+
+    assert(Parser::runAllPostprocess(true));
+    assert(all.size() == 31); // argv[0] is the program name
+    assert(string_view(errBuf, errSize).find("Too many arguments, only the first 32 are parsed.") != string_view::npos);
+
+    fprintf(stderr, "Too many arguments PASSED\n\n");
+}
+
+void testTooManyOpts() {
+    fprintf(stderr, "--- Testing too many bundled options ---\n");
+    resetOutput();
+    // 40 distinct short options in one argument, more than the 32 slots
+    vector<string> args = {"./prog", "-abcdefgijklmnopqrstuvwxyzABCDEFGIJKLMNO"};
+    auto           argv = create_argv(args);
+
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+
+    assert(Parser::runAllPostprocess(true));
+    string_view err(errBuf, errSize);
+    assert(err.find("Too many options, the rest are ignored. Increase MaxArgc of FixedParser.") != string_view::npos);
+    assert(err.find("Too many arguments") == string_view::npos);
+
+    fprintf(stderr, "Too many bundled options PASSED\n\n");
+}
+
+void testOptionLookup() {
+    fprintf(stderr, "--- Testing option lookup ---\n");
+    resetOutput();
+    // Keys out of order and repeated, the last occurrence wins
+    vector<string> args = {"./prog", "--zeta", "1", "-b", "--alpha=x", "--num", "5", "--zeta=2",
+                           "-n", "6", "--unknown-b", "--unknown-a", "-bz"};
+    auto           argv = create_argv(args);
+
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+
+    auto zeta  = Parser::getString("zeta", "Zeta.");
+    auto alpha = Parser::getString("alpha", "Alpha.");
+    auto num   = Parser::getInt("n,num", "Number.");
+    auto b     = Parser::hasFlag("b", "B.");
+    auto z     = Parser::hasFlag("z", "Z.");
+    auto a     = Parser::hasFlag("a", "A.");
+
+    assert(Parser::tryToPrintInvalidOpts(true));
+    assert(!Parser::finalize(true));
+    assert(zeta == "2");
+    assert(alpha == "x");
+    assert(num == 6);
+    assert(b && z && !a);
+    // Unknown options are reported in command-line order
+    string_view err(errBuf, errSize);
+    auto        posB = err.find("--unknown-b");
+    auto        posA = err.find("--unknown-a");
+    assert(posB != string_view::npos && posA != string_view::npos && posB < posA);
+
+    fprintf(stderr, "Option lookup PASSED\n\n");
+}
+
+size_t helpAllocsBefore = 0;
+
+// The help page exits the program, so it is checked at exit
+void checkHelpOutput() {
+    assert(allocCount == helpAllocsBefore);
+    string_view out(outBuf, outSize);
+    assert(out.rfind("Fixed test.\n\nUsage: fixed [OPTIONS] input [extra]...\n", 0) == 0);
+    assert(out.find("  -c, --count <integer>  Counter. [default: 42]\n") != string_view::npos);
+    assert(out.find("  -r, --rate <float>     Rate. [default: 3.0]\n") != string_view::npos);
+    assert(out.find("      --enable <bool>    Enable. [default: false]\n") != string_view::npos);
+    assert(out.find("  extra  Extra files. [default: [\"a\", \"b\"]]\n") != string_view::npos);
+    assert(out.find("  -h, --help             Show this help message and exit\n") != string_view::npos);
+
+    fprintf(stderr, "Help without heap allocations PASSED\n\n");
+    fprintf(stderr, "All tests passed!\n");
+}
+
+void testHelpWithoutHeap() {
+    fprintf(stderr, "--- Testing help without heap allocations ---\n");
+    resetOutput();
+    std::atexit(checkHelpOutput);
+    vector<string> args = {"/bin/fixed", "-h"};
+    auto           argv = create_argv(args);
+
+    static constexpr string_view DEFAULT_EXTRA[] = {"a", "b"};
+
+    helpAllocsBefore = allocCount;
+    Parser::setDescription("Fixed test.");
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+
+    auto count  = Parser::getInt("c,count", "Counter.", 42);
+    auto rate   = Parser::getDouble("r,rate", "Rate.", 3);
+    auto enable = Parser::getBool("enable", "Enable.");
+    auto input  = Parser::getPositional("input", "Input file.");
+    auto extra  = Parser::getRemainingPositionals("extra", "Extra files.", false, DEFAULT_EXTRA);
+    (void)count, (void)rate, (void)enable, (void)input, (void)extra;
+
+    Parser::runAllPostprocess();
+    assert(false); // Should not reach here
+}
+
+int main() {
+    testParseWithoutHeap();
+    testErrorsWithoutHeap();
+    testTooManyArgs();
+    testTooManyOpts();
+    testOptionLookup();
+    testHelpWithoutHeap();
+
+    return 1;
+}
@@ -0,0 +1,72 @@
+#define ARGLITE_ENABLE_FORMATTER
+#define ARGLITE_NO_IOSTREAM
+
+#include "ArgLite/Core.hpp"
+#include <cassert>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#if defined(_GLIBCXX_IOSTREAM) || defined(_LIBCPP_IOSTREAM)
+#error "<iostream> must not be included when ARGLITE_NO_IOSTREAM is defined"
+#endif
+
+using namespace std;
+using ArgLite::OutputSink;
+using ArgLite::Parser;
+
+string helpOut;
+string helpErr;
+
+// Helper function to create argv
+vector<char *> create_argv(const vector<string> &args) {
+    vector<char *> argv;
+    for (const auto &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    return argv;
+}
+
+// The help page exits the program, so it is checked at exit
+void checkHelpOutput() {
+    assert(helpErr.empty());
+    assert(helpOut.find("[default: -42]") != string::npos);
+    assert(helpOut.find("[default: 18446744073709551615]") != string::npos);
+    assert(helpOut.find("[default: 2.5]") != string::npos);
+    assert(helpOut.find("[default: 3.0]") != string::npos);
+    assert(helpOut.find("[default: 0.333333]") != string::npos);
+    assert(helpOut.find("[default: ;]") != string::npos);
+    assert(helpOut.find("[default: out.txt]") != string::npos);
+
+    fprintf(stderr, "Default values rendered without iostreams PASSED\n\n");
+    fprintf(stderr, "All tests passed!\n");
+}
+
+void testDefaultValuesInHelp() {
+    fprintf(stderr, "--- Testing default values rendered without iostreams ---\n");
+    Parser::setOutput(OutputSink::string(helpOut), OutputSink::string(helpErr));
+    std::atexit(checkHelpOutput);
+
+    vector<string> args = {"./noIostream", "-h"};
+    auto           argv = create_argv(args);
+    Parser::setDescription("No iostream test.");
+    Parser::preprocess(argv.size(), argv.data());
+
+    auto count  = Parser::get<int>("c,count", "Counter.").setDefault(-42).get();
+    auto limit  = Parser::get<unsigned long long>("l,limit", "Limit.").setDefault(18446744073709551615ULL).get();
+    auto ratio  = Parser::get<double>("r,ratio", "Ratio.").setDefault(2.5).get();
+    auto scale  = Parser::get<float>("s,scale", "Scale.").setDefault(3).get();
+    auto tiny   = Parser::get<double>("t,tiny", "Tiny.").setDefault(1.0 / 3).get();
+    auto sep    = Parser::get<char>("p,sep", "Separator.").setDefault(';').get();
+    auto output = Parser::get<string>("o,output", "Output.").setDefault("out.txt").get();
+    (void)count, (void)limit, (void)ratio, (void)scale, (void)tiny, (void)sep, (void)output;
+
+    Parser::runAllPostprocess();
+    assert(false); // Should not reach here
+}
+
+int main() {
+    testDefaultValuesInHelp();
+
+    return 1;
+}
@@ -44,6 +44,15 @@ def main():
         ]
     )
 
+    all_tests_passed &= test_case(
+        "Empty value in --opt= form",
+        ["--name=", "--optional="],
+        expected_output_substrings=[
+            "User Name  : \n",
+            "Optional   : \n",
+        ]
+    )
+
     all_tests_passed &= test_case(
         "Optional option -o, --optional: not set",
         ["-nAdmin", "-x"],
@@ -62,11 +71,56 @@ def main():
         ]
     )
 
+    all_tests_passed &= test_case(
+        "Lazy default values: options not provided",
+        ["-nAdmin"],
+        expected_output_substrings=[
+            "Jobs       : 4 (default function calls: 1)",
+            "Level      : 6",
+        ]
+    )
+
+    all_tests_passed &= test_case(
+        "Lazy default values: options provided",
+        ["-nAdmin", "-j", "8", "--level=1"],
+        expected_output_substrings=[
+            "Jobs       : 8 (default function calls: 0)",
+            "Level      : 1",
+        ]
+    )
+
+    all_tests_passed &= test_case(
+        "Lazy default values in the help message",
+        ["-h"],
+        expected_output_substrings=[
+            "Number of jobs. [default: number of CPUs]",
+            "Compression level. [default: 6]",
+        ]
+    )
+
     all_tests_passed &= test_case(
         "Usage in the help message",
         ["-h"],
         expected_output_substrings=[
             "[OPTIONS] --name=<string>",
+            "Optional argument. Its description is not a literal.",
+        ]
+    )
+
+    all_tests_passed &= test_case(
+        "Help requested with invalid values",
+        ["-h", "-i", "abc", "-n"],
+        expected_output_substrings=[
+            "Help requested, setup skipped.",
+            "-h, --help",
+        ]
+    )
+
+    all_tests_passed &= test_case(
+        "Version printed in preprocess",
+        ["--version", "-h", "-i", "abc"],
+        expected_output_substrings=[
+            "1.2.3",
         ]
     )
 
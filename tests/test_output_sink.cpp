@@ -0,0 +1,165 @@
+#define ARGLITE_ENABLE_FORMATTER
+
+#include "ArgLite/Core.hpp"
+#include <cassert>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using ArgLite::Formatter;
+using ArgLite::OutputSink;
+using ArgLite::Parser;
+
+// Helper function to create argv
+vector<char *> create_argv(const vector<string> &args) {
+    vector<char *> argv;
+    for (const auto &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    return argv;
+}
+
+void testUnknownOptsCapturedInString() {
+    cerr << "--- Testing unknown options captured in a string ---\n";
+    string out;
+    string err;
+    Parser::setOutput(OutputSink::string(out), OutputSink::string(err));
+
+    vector<string> args = {"./sink", "--unknown"};
+    auto           argv = create_argv(args);
+    Parser::setDescription("Sink test.");
+    Parser::preprocess(argv.size(), argv.data());
+
+    auto verbose = Parser::hasFlag("v,verbose", "Verbose output.");
+    auto count   = Parser::get<int>("c,count", "Counter.").setDefault(3).get();
+    (void)verbose;
+    (void)count;
+
+    assert(Parser::runAllPostprocess(true));
+    assert(out.empty());
+    // No ANSI sequences are written to a string
+    assert(err.find('\x1b') == string::npos);
+    assert(err.find("Unrecognized option '--unknown'") != string::npos);
+
+    cerr << "Unknown options captured in a string PASSED\n"
+         << '\n';
+}
+
+void testErrorsCapturedInBuffer() {
+    cerr << "--- Testing errors captured in a fixed buffer ---\n";
+    string out;
+    char   buf[64];
+    size_t size = 0;
+    Parser::setOutput(OutputSink::string(out), OutputSink::buffer(buf, sizeof(buf), &size));
+
+    vector<string> args = {"./sink", "-c", "abc"};
+    auto           argv = create_argv(args);
+    Parser::preprocess(argv.size(), argv.data());
+
+    auto count = Parser::get<int>("c,count", "Counter.").get();
+    (void)count;
+
+    assert(Parser::runAllPostprocess(true));
+    // The report is truncated to the buffer size
+    assert(size == sizeof(buf));
+    assert(string(buf, size).rfind("Errors occurred", 0) == 0);
+
+    cerr << "Errors captured in a fixed buffer PASSED\n"
+         << '\n';
+}
+
+void testStyledFragments() {
+    cerr << "--- Testing styled fragments ---\n";
+    string out;
+    auto   sink = OutputSink::string(out);
+
+    // A string sink is never a terminal, so the fragments are appended as they are
+    assert(!Formatter::isEnabled(sink));
+    assert(Formatter::styled("name", Formatter::Style::Bold, sink).code.empty());
+    Formatter::append(out, "Error: ", Formatter::Style::Red, sink);
+    Formatter::append(out, "name", Formatter::Style::Bold, sink);
+    assert(out == "Error: name");
+
+    // The legacy functions return the same fragments
+    out += Formatter::bold(" and more", sink);
+    assert(out == "Error: name and more");
+    string copy = Formatter::yellow("value", sink);
+    assert(copy == "value");
+
+    // The field width covers the whole fragment
+    ostringstream os;
+    os << left << setw(6) << Formatter::styled("ab", Formatter::Style::Bold, sink) << '|';
+    assert(os.str() == "ab    |");
+
+    cerr << "Styled fragments PASSED\n"
+         << '\n';
+}
+
+void testErrorRecords() {
+    cerr << "--- Testing error records ---\n";
+    string out;
+    string err;
+    Parser::setOutput(OutputSink::string(out), OutputSink::string(err));
+
+    vector<string> args = {"./sink", "-c", "abc", "--name", "--", "x"};
+    auto           argv = create_argv(args);
+    Parser::preprocess(argv.size(), argv.data());
+
+    auto count = Parser::get<int>("c,count", "Counter.").get();
+    auto name  = Parser::get<string>("n,name", "Name.").get();
+    auto level = Parser::get<int>("level", "Level.").required().get();
+    auto input = Parser::getPositional<int>("input", "Input number.");
+    auto extra = Parser::getRemainingPositionals("extra", "Extra files.");
+    Parser::pushBackErrorMsg("Custom error.");
+    (void)count, (void)name, (void)level, (void)input, (void)extra;
+
+    using Code         = Parser::ErrorCode;
+    const auto &errors = Parser::getErrors();
+    assert(errors.size() == 6);
+
+    assert(errors[0].code == Code::InvalidValue);
+    assert(errors[0].argvIndex == 2);
+    assert(errors[0].value == "abc");
+    assert(Parser::errorToString(errors[0]) == "Invalid value for option '-c, --count'. Expected a integer, but got 'abc'.");
+
+    assert(errors[1].code == Code::MissingValue);
+    assert(errors[1].argvIndex == 3);
+    assert(Parser::errorToString(errors[1]) == "Option '-n, --name' requires a value.");
+
+    assert(errors[2].code == Code::MissingOption);
+    assert(errors[2].argvIndex == -1);
+    assert(Parser::errorToString(errors[2]) == "Option '--level' is required, you cannot run this command without it.");
+
+    assert(errors[3].code == Code::InvalidPositional);
+    assert(errors[3].argvIndex == 5);
+    assert(Parser::errorToString(errors[3]) == "Invalid value for positional argument 'input'. Expected a integer, but got 'x'.");
+
+    assert(errors[4].code == Code::MissingPositional);
+    assert(Parser::errorToString(errors[4]) == "Missing required positional arguments 'extra'.");
+
+    assert(errors[5].code == Code::Custom);
+    assert(Parser::errorToString(errors[5]) == "Custom error.");
+
+    // The messages are printed in the same order
+    assert(Parser::runAllPostprocess(true));
+    auto invalidPos = err.find("Invalid value for option '-c, --count'");
+    auto customPos  = err.find("Custom error.");
+    assert(invalidPos != string::npos && customPos != string::npos && invalidPos < customPos);
+
+    cerr << "Error records PASSED\n"
+         << '\n';
+}
+
+int main() {
+    testUnknownOptsCapturedInString();
+    testErrorsCapturedInBuffer();
+    testStyledFragments();
+    testErrorRecords();
+
+    cerr << "All tests passed!\n";
+
+    return 0;
+}
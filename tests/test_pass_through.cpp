@@ -0,0 +1,113 @@
+#include "ArgLite/Core.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using ArgLite::OutputSink;
+using ArgLite::Parser;
+using Status = Parser::ParseStatus;
+
+string out;
+string err;
+
+// Helper function to create argv
+vector<char *> create_argv(const vector<string> &args) {
+    vector<char *> argv;
+    for (const auto &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    return argv;
+}
+
+struct Wrapper {
+    bool   verbose;
+    int    jobs;
+    string input;
+};
+
+Status parse(const vector<string> &args, Wrapper &cfg, vector<string> &unknown, bool withPositional = false) {
+    out.clear();
+    err.clear();
+    auto argv = create_argv(args);
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+
+    cfg.verbose = Parser::hasFlag("v,verbose", "Verbose output.");
+    cfg.jobs    = Parser::get<int>("j,jobs", "Number of jobs.").setDefault(1).get();
+    if (withPositional) { cfg.input = Parser::getPositional("input", "Input file.", false); }
+
+    auto status = Parser::postprocess();
+
+    // The views stay valid after the post-processing
+    const auto &unknownArgs = Parser::getUnknownArgs();
+    unknown.assign(unknownArgs.begin(), unknownArgs.end());
+    for (size_t i = 0; i < unknownArgs.size(); i++) {
+        bool inArgv = false;
+        for (auto *arg : argv) { inArgv = inArgv || arg == unknownArgs[i]; }
+        assert(inArgv);
+    }
+    return status;
+}
+
+void testPassThrough() {
+    cerr << "--- Testing passing unknown options through ---\n";
+    Wrapper        cfg{};
+    vector<string> unknown;
+
+    // Argv order is kept, with the values of the options
+    assert(parse({"./wrap", "--zeta", "1", "-v", "--alpha=2", "-j", "4", "-x", "--beta", "-O3"}, cfg, unknown) == Status::Ok);
+    assert(cfg.verbose);
+    assert(cfg.jobs == 4);
+    assert((unknown == vector<string>{"--zeta", "1", "--alpha=2", "-x", "--beta", "-O3"}));
+    assert(err.empty());
+
+    // Repeated unknown options, and a bundle with unknown short options kept as a whole
+    assert(parse({"./wrap", "-D", "a", "-vxy", "-D", "b", "-j", "2"}, cfg, unknown) == Status::Ok);
+    assert(cfg.verbose);
+    assert(cfg.jobs == 2);
+    assert((unknown == vector<string>{"-D", "a", "-vxy", "-D", "b"}));
+
+    // A positional argument takes the value back
+    assert(parse({"./wrap", "--fast", "in.txt"}, cfg, unknown, true) == Status::Ok);
+    assert(cfg.input == "in.txt");
+    assert((unknown == vector<string>{"--fast"}));
+
+    // Help is still handled
+    assert(parse({"./wrap", "--fast", "-h"}, cfg, unknown) == Status::HelpPrinted);
+    assert(unknown.empty());
+
+    // Nothing unknown
+    assert(parse({"./wrap", "-v"}, cfg, unknown) == Status::Ok);
+    assert(unknown.empty());
+
+    cerr << "Passing unknown options through PASSED\n"
+         << '\n';
+}
+
+void testReported() {
+    cerr << "--- Testing reporting unknown options ---\n";
+    Wrapper        cfg{};
+    vector<string> unknown;
+
+    Parser::setPassThroughUnknown(false);
+    assert(parse({"./wrap", "--zeta", "1"}, cfg, unknown) == Status::Error);
+    assert(err.find("--zeta") != string::npos);
+    Parser::setPassThroughUnknown();
+
+    cerr << "Reporting unknown options PASSED\n"
+         << '\n';
+}
+
+int main() {
+    Parser::setEmbeddedMode();
+    Parser::setOutput(OutputSink::string(out), OutputSink::string(err));
+    Parser::setPassThroughUnknown();
+
+    testPassThrough();
+    testReported();
+
+    cerr << "All tests passed!\n";
+
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include "ArgLite/Core.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using ArgLite::OutputSink;
+using ArgLite::Parser;
+using ArgLite::SubParser;
+using Status = Parser::ParseStatus;
+
+string out;
+string err;
+
+// Helper function to create argv
+vector<char *> create_argv(const vector<string> &args) {
+    vector<char *> argv;
+    for (const auto &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    return argv;
+}
+
+vector<string> toStrings(const vector<char *> &argv) { return {argv.begin(), argv.end()}; }
+
+void testPermute() {
+    cerr << "--- Testing permuting argv in place ---\n";
+    vector<string> args = {"./cc", "in1.c", "-O", "2", "in2.c", "--", "-g", "--unknown", "x"};
+    auto           argv = create_argv(args);
+
+    out.clear();
+    err.clear();
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+    auto level  = Parser::get<int>("O", "Optimization level.").get();
+    auto output = Parser::getPositional("output", "Output file.");
+    auto inputs = Parser::getRemainingPositionalsInPlace(argv.data(), "inputs", "Input files.");
+
+    assert(level == 2);
+    assert(output == "in1.c");
+    // Options first, then the positional arguments, both in their original order
+    assert((toStrings(argv) == vector<string>{"./cc", "-O", "2", "--", "in1.c", "in2.c", "-g", "--unknown", "x"}));
+    assert(inputs.size == 4);
+    assert(inputs.data == argv.data() + 5);
+    assert((vector<string>(inputs.begin(), inputs.end()) == vector<string>{"in2.c", "-g", "--unknown", "x"}));
+
+    assert(Parser::postprocess() == Status::Ok);
+
+    cerr << "Permuting argv in place PASSED\n"
+         << '\n';
+}
+
+void testIndicesFollow() {
+    cerr << "--- Testing indices after permuting ---\n";
+    vector<string> args = {"./cc", "a", "-n", "abc", "b", "--zeta", "c", "-x"};
+    auto           argv = create_argv(args);
+
+    out.clear();
+    err.clear();
+    Parser::setPassThroughUnknown();
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+    auto count  = Parser::get<int>("n", "Count.").setDefault(1).get();
+    auto inputs = Parser::getRemainingPositionalsInPlace(argv.data(), "inputs", "Input files.");
+
+    assert(count == 1);
+    assert((toStrings(argv) == vector<string>{"./cc", "-n", "abc", "--zeta", "-x", "a", "b", "c"}));
+    assert((vector<string>(inputs.begin(), inputs.end()) == vector<string>{"a", "b", "c"}));
+
+    // The error points at the value in its new place
+    const auto &errors = Parser::getErrors();
+    assert(errors.size() == 1);
+    assert(errors[0].argvIndex == 2);
+    assert(string(argv[errors[0].argvIndex]) == "abc");
+
+    assert(Parser::postprocess() == Status::Error);
+    assert(err.find("abc") != string::npos);
+
+    // Unknown flags that lost their value to a positional argument are found in their new place
+    const auto &unknown = Parser::getUnknownArgs();
+    assert((vector<string>(unknown.begin(), unknown.end()) == vector<string>{"--zeta", "-x"}));
+    Parser::setPassThroughUnknown(false);
+
+    cerr << "Indices after permuting PASSED\n"
+         << '\n';
+}
+
+void testSubcommand() {
+    cerr << "--- Testing permuting for a subcommand ---\n";
+    SubParser build("build", "Build the project.");
+
+    vector<string> args = {"./tool", "build", "t1", "-v", "t2"};
+    auto           argv = create_argv(args);
+
+    out.clear();
+    err.clear();
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+    auto verbose = build.hasFlag("v,verbose", "Verbose output.");
+    auto targets = build.getRemainingPositionalsInPlace(argv.data(), "targets", "Targets.");
+
+    assert(verbose);
+    assert((toStrings(argv) == vector<string>{"./tool", "build", "-v", "t1", "t2"}));
+    assert((vector<string>(targets.begin(), targets.end()) == vector<string>{"t1", "t2"}));
+
+    // Nothing left and required
+    auto more = build.getRemainingPositionalsInPlace(argv.data(), "more", "More.");
+    assert(more.empty());
+    assert(Parser::postprocess() == Status::Error);
+    assert(err.find("more") != string::npos);
+
+    cerr << "Permuting for a subcommand PASSED\n"
+         << '\n';
+}
+
+int main() {
+    Parser::setEmbeddedMode();
+    Parser::setOutput(OutputSink::string(out), OutputSink::string(err));
+
+    testPermute();
+    testIndicesFollow();
+    testSubcommand();
+
+    cerr << "All tests passed!\n";
+
+    return 0;
+}
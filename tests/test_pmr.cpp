@@ -0,0 +1,159 @@
+#define ARGLITE_ENABLE_PMR
+
+#include "ArgLite/Core.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace std;
+using ArgLite::OutputSink;
+using ArgLite::Parser;
+
+// Count heap allocations, the internal data must not make any when a resource is set
+size_t allocCount = 0;
+
+void *operator new(size_t size) {
+    allocCount++;
+    if (void *ptr = malloc(size)) { return ptr; }
+    throw bad_alloc();
+}
+void *operator new[](size_t size) { return operator new(size); }
+void  operator delete(void *ptr) noexcept { free(ptr); }
+void  operator delete[](void *ptr) noexcept { free(ptr); }
+void  operator delete(void *ptr, size_t) noexcept { free(ptr); }
+void  operator delete[](void *ptr, size_t) noexcept { free(ptr); }
+
+// Counts the calls forwarded to the upstream resource
+class CountingResource : public pmr::memory_resource {
+public:
+    explicit CountingResource(pmr::memory_resource *upstream) : upstream_(upstream) {}
+
+    size_t allocs   = 0;
+    size_t deallocs = 0;
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        allocs++;
+        return upstream_->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *ptr, size_t bytes, size_t alignment) override {
+        deallocs++;
+        upstream_->deallocate(ptr, bytes, alignment);
+    }
+    bool do_is_equal(const pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    pmr::memory_resource *upstream_;
+};
+
+char   errBuf[4096];
+size_t errSize = 0;
+
+// Helper function to create argv
+vector<char *> create_argv(const vector<string> &args) {
+    vector<char *> argv;
+    for (const auto &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    return argv;
+}
+
+void testParseWithoutHeap() {
+    fprintf(stderr, "--- Testing parsing without heap allocations ---\n");
+    vector<string> args = {"./pmr", "-vv", "-c", "42", "--name=Ada", "in"};
+    auto           argv = create_argv(args);
+
+    alignas(max_align_t) char        buf[16384];
+    pmr::monotonic_buffer_resource arena(buf, sizeof(buf), pmr::null_memory_resource());
+    CountingResource                 resource(&arena);
+
+    auto allocsBefore = allocCount;
+    Parser::setMemoryResource(&resource, true);
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+
+    auto verbose = Parser::countFlag("v,verbose", "Verbose output.");
+    auto count   = Parser::get<int>("c,count", "Counter.").setDefault(3).get();
+    auto name    = Parser::get<string>("n,name", "Name.").get();
+    auto level   = Parser::get<int>("l,level", "Level.").setDefault(7).get();
+    auto input   = Parser::getPositional("input", "Input file.");
+
+    assert(resource.allocs > 0);
+    auto deallocsBefore = resource.deallocs;
+    assert(!Parser::runAllPostprocess(true));
+    assert(allocCount == allocsBefore);
+    // The internal data is abandoned, so nothing is returned to the arena
+    assert(resource.deallocs == deallocsBefore);
+
+    assert(verbose == 2);
+    assert(count == 42);
+    assert(name == "Ada");
+    assert(level == 7);
+    assert(input == "in");
+
+    fprintf(stderr, "Parsing without heap allocations PASSED\n\n");
+}
+
+void testErrorsFromResource() {
+    fprintf(stderr, "--- Testing error messages allocated from the resource ---\n");
+    errSize = 0;
+    Parser::setOutput(OutputSink::fd(1), OutputSink::buffer(errBuf, sizeof(errBuf), &errSize));
+    vector<string> args = {"./pmr", "--count", "abc", "--name"};
+    auto           argv = create_argv(args);
+
+    CountingResource resource(pmr::new_delete_resource());
+    Parser::setMemoryResource(&resource);
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+
+    auto count = Parser::get<int>("c,count", "Counter.").setDefault(3).get();
+    auto name  = Parser::get<string>("n,name", "Name.").get();
+    (void)count, (void)name;
+
+    auto allocsBefore = resource.allocs;
+    Parser::pushBackErrorMsg("A custom error message that is too long for the small string buffer.");
+    assert(resource.allocs > allocsBefore);
+
+    auto deallocsBefore = resource.deallocs;
+    assert(Parser::runAllPostprocess(true));
+    assert(resource.deallocs > deallocsBefore);
+    // Every element is destroyed, so the memory is returned to the resource
+    assert(resource.deallocs == resource.allocs);
+
+    string_view err(errBuf, errSize);
+    assert(err.find("Invalid value for option '-c, --count'. Expected a integer, but got 'abc'.") != string_view::npos);
+    assert(err.find("Option '-n, --name' requires a value.") != string_view::npos);
+    assert(err.find("A custom error message that is too long for the small string buffer.") != string_view::npos);
+
+    fprintf(stderr, "Error messages allocated from the resource PASSED\n\n");
+}
+
+void testDefaultResourceAfterParsing() {
+    fprintf(stderr, "--- Testing the default resource after parsing ---\n");
+    vector<string> args = {"./pmr", "-c", "5", "--name", "a name that is too long for the small string buffer"};
+    auto           argv = create_argv(args);
+
+    // The resources of the previous tests are gone, the default resource is used again
+    auto allocsBefore = allocCount;
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+    auto count = Parser::get<int>("c,count", "Counter.").get();
+    auto name  = Parser::get<string>("n,name", "Name.").get();
+    assert(!Parser::runAllPostprocess(true));
+
+    assert(allocCount > allocsBefore);
+    assert(count == 5);
+    assert(name == "a name that is too long for the small string buffer");
+
+    fprintf(stderr, "Default resource after parsing PASSED\n\n");
+}
+
+int main() {
+    testParseWithoutHeap();
+    testErrorsFromResource();
+    testDefaultResourceAfterParsing();
+
+    fprintf(stderr, "All tests passed!\n");
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+#define ARGLITE_ENABLE_CONFIG_FILE
+
+#include "ArgLite/Reload.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using ArgLite::ConfigReloader;
+using ArgLite::OutputSink;
+using ArgLite::Parser;
+
+string err;
+
+const string configPath = "/tmp/arglite_reload.ini";
+
+// Replaces the file like an editor, by renaming a new one over it
+void writeConfig(const string &content) {
+    string tmpPath = configPath + ".tmp";
+    FILE  *file    = fopen(tmpPath.c_str(), "wb");
+    assert(file != nullptr);
+    fwrite(content.data(), 1, content.size(), file);
+    fclose(file);
+    assert(rename(tmpPath.c_str(), configPath.c_str()) == 0);
+}
+
+string configOf(int threads) {
+    return "threads = " + to_string(threads) + "\nworkers = " + to_string(threads * 2) + "\n";
+}
+
+void declareOptions() {
+    auto threads = Parser::get<int>("t,threads", "Number of threads.").setDefault(1).get();
+    auto workers = Parser::get<int>("w,workers", "Number of workers.").setDefault(2).get();
+    auto name    = Parser::get<string>("n,name", "Name.").get();
+    (void)threads, (void)workers, (void)name;
+}
+
+void testReload(ConfigReloader &reloader) {
+    cerr << "--- Testing reloading the config file ---\n";
+    assert(!reloader.read());
+    assert(reloader.reload());
+    assert(reloader.version() == 1);
+    {
+        auto args = reloader.read();
+        assert(args);
+        assert(args->get<int>("threads") == 4);
+        assert(args->get<int>("workers") == 8);
+        // The command line still wins
+        assert(args->getString("name") == "cli");
+    }
+
+    // Nothing changed
+    assert(!reloader.poll());
+
+    writeConfig(configOf(6));
+    assert(reloader.poll());
+    assert(reloader.version() == 2);
+    assert(reloader.read()->get<int>("threads") == 6);
+
+    // An invalid file keeps the current snapshot
+    writeConfig("threads = many\n");
+    assert(!reloader.poll());
+    assert(reloader.version() == 2);
+    assert(reloader.read()->get<int>("threads") == 6);
+    assert(err.find("Invalid value for key 'threads'") != string::npos);
+
+    cerr << "Reloading the config file PASSED\n"
+         << '\n';
+}
+
+void testConcurrentReaders(ConfigReloader &reloader) {
+    cerr << "--- Testing readers during reloads ---\n";
+    atomic<bool> stop{false};
+    atomic<long> reads{0};
+
+    vector<thread> readers;
+    for (int i = 0; i < 4; i++) {
+        readers.emplace_back([&]() {
+            long count = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                auto args = reloader.read();
+                // Both values always come from the same snapshot
+                assert(args->get<int>("workers") == args->get<int>("threads") * 2);
+                count++;
+            }
+            reads += count;
+        });
+    }
+
+    for (int i = 1; i <= 50; i++) {
+        writeConfig(configOf(i));
+        assert(reloader.reload());
+    }
+    stop = true;
+    for (auto &reader : readers) { reader.join(); }
+
+    assert(reloader.read()->get<int>("threads") == 50);
+    assert(reads > 0);
+
+    cerr << "Readers during reloads PASSED\n"
+         << '\n';
+}
+
+void testParseOnAnotherThread(ConfigReloader &reloader) {
+    cerr << "--- Testing a reload during a parse of another thread ---\n";
+    Parser::setEmbeddedMode();
+    static const char *argv[] = {"./app", "-v"};
+    Parser::preprocess(2, argv);
+
+    atomic<bool> done{false};
+    bool         published = false;
+    thread       worker([&]() {
+        published = reloader.reload();
+        done      = true;
+    });
+
+    // The reload waits until the parse is post-processed
+    this_thread::sleep_for(chrono::milliseconds(50));
+    assert(!done);
+    assert(Parser::hasFlag("v,verbose", "Verbose output."));
+    assert(Parser::postprocess() == Parser::ParseStatus::Ok);
+
+    worker.join();
+    assert(done && published);
+    assert(reloader.read()->get<int>("threads") == 50);
+    Parser::setEmbeddedMode(false);
+
+    cerr << "Reload during a parse of another thread PASSED\n"
+         << '\n';
+}
+
+int main() {
+    Parser::setOutput(OutputSink::string(err), OutputSink::string(err));
+    writeConfig(configOf(4));
+
+    static const char *argv[] = {"./reload", "--name", "cli"};
+    ConfigReloader     reloader(3, argv, configPath, declareOptions);
+
+    testReload(reloader);
+    testConcurrentReaders(reloader);
+    testParseOnAnotherThread(reloader);
+
+    cerr << "All tests passed!\n";
+
+    return 0;
+}
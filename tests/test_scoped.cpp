@@ -0,0 +1,125 @@
+#include "ArgLite/Core.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using ArgLite::OutputSink;
+using ArgLite::Parser;
+using Status = Parser::ParseStatus;
+
+string out;
+string err;
+
+// Helper function to create argv
+vector<char *> create_argv(const vector<string> &args) {
+    vector<char *> argv;
+    for (const auto &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    return argv;
+}
+
+// The values of each group
+template <typename T>
+vector<vector<T>> groupValues(const Parser::ScopedValues<T> &scoped, const vector<int> &anchors) {
+    auto              offsets = scoped.groupOffsets(anchors);
+    vector<vector<T>> groups;
+    for (size_t k = 0; k + 1 < offsets.size(); k++) {
+        groups.emplace_back(scoped.values.begin() + static_cast<ptrdiff_t>(offsets[k]),
+                            scoped.values.begin() + static_cast<ptrdiff_t>(offsets[k + 1]));
+    }
+    return groups;
+}
+
+void testAnchorOption() {
+    cerr << "--- Testing options scoped by an anchor option ---\n";
+    vector<string> args = {"./conv", "-c", "copy", "-i", "a.mp4", "--codec=h264", "--rate", "30", "--input", "b.mp4",
+                          "-i", "c.mp4", "-r", "60", "-c", "vp9", "-r", "25", "out.mkv"};
+    auto           argv = create_argv(args);
+
+    out.clear();
+    err.clear();
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+    auto inputs = Parser::get<string>("i,input", "Input file.").getScoped();
+    auto codecs = Parser::get<string>("c,codec", "Codec.").getScoped();
+    auto rates  = Parser::get<int>("r,rate", "Frame rate.").getScoped();
+    auto output = Parser::getPositional("output", "Output file.");
+    assert(Parser::postprocess() == Status::Ok);
+
+    assert((inputs.values == vector<string>{"a.mp4", "b.mp4", "c.mp4"}));
+    assert((inputs.argvIndices == vector<int>{4, 9, 11}));
+    assert((codecs.argvIndices == vector<int>{2, 5, 15}));
+
+    // One group per input, and the options after the last input
+    assert((groupValues(codecs, inputs.argvIndices) == vector<vector<string>>{{"copy"}, {"h264"}, {}, {"vp9"}}));
+    assert((groupValues(rates, inputs.argvIndices) == vector<vector<int>>{{}, {30}, {}, {60, 25}}));
+    assert(output == "out.mkv");
+
+    cerr << "Options scoped by an anchor option PASSED\n"
+         << '\n';
+}
+
+void testPositionalAnchors() {
+    cerr << "--- Testing options scoped by positional arguments ---\n";
+    vector<string> args = {"./tool", "-q", "5", "x.png", "y.png", "-q", "9", "-v", "-s", "2,3", "z.png", "-s", "4"};
+    auto           argv = create_argv(args);
+
+    out.clear();
+    err.clear();
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+    auto verbose = Parser::hasFlag("v,verbose", "Verbose output.");
+    auto quality = Parser::get<int>("q,quality", "Quality.").getScoped();
+    auto scales  = Parser::get<int>("s,scale", "Scales.").getScoped(',');
+    auto anchors = Parser::getPositionalArgvIndices();
+    auto files   = Parser::getRemainingPositionals("files", "Files.");
+    assert(Parser::postprocess() == Status::Ok);
+
+    assert(verbose);
+    assert((files == vector<string>{"x.png", "y.png", "z.png"}));
+    assert((anchors == vector<int>{3, 4, 10}));
+    assert((groupValues(quality, anchors) == vector<vector<int>>{{5}, {}, {9}, {}}));
+    // The parts of a split value share its argv index
+    assert((scales.argvIndices == vector<int>{9, 9, 12}));
+    assert((groupValues(scales, anchors) == vector<vector<int>>{{}, {}, {2, 3}, {4}}));
+
+    cerr << "Options scoped by positional arguments PASSED\n"
+         << '\n';
+}
+
+void testInvalidAndMissing() {
+    cerr << "--- Testing invalid and missing scoped values ---\n";
+    vector<string> args = {"./conv", "-r", "abc", "-i", "a.mp4"};
+    auto           argv = create_argv(args);
+
+    out.clear();
+    err.clear();
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+    auto inputs = Parser::get<string>("i,input", "Input file.").getScoped();
+    auto rates  = Parser::get<int>("r,rate", "Frame rate.").getScoped();
+    auto codecs = Parser::get<string>("c,codec", "Codec.").getScoped();
+    assert(Parser::postprocess() == Status::Error);
+    assert(err.find("abc") != string::npos);
+
+    assert(rates.values.empty() && rates.argvIndices.empty());
+    assert(codecs.values.empty());
+    assert((rates.groupOffsets(inputs.argvIndices) == vector<size_t>{0, 0, 0}));
+    assert((rates.groupOffsets({}) == vector<size_t>{0, 0}));
+
+    cerr << "Invalid and missing scoped values PASSED\n"
+         << '\n';
+}
+
+int main() {
+    Parser::setEmbeddedMode();
+    Parser::setOutput(OutputSink::string(out), OutputSink::string(err));
+
+    testAnchorOption();
+    testPositionalAnchors();
+    testInvalidAndMissing();
+
+    cerr << "All tests passed!\n";
+
+    return 0;
+}
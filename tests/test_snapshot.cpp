@@ -0,0 +1,171 @@
+#include "ArgLite/Core.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace std;
+using ArgLite::ParsedArgs;
+using ArgLite::Parser;
+
+// Helper function to create argv
+vector<char *> create_argv(const vector<string> &args) {
+    vector<char *> argv;
+    for (const auto &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    return argv;
+}
+
+shared_ptr<const ParsedArgs> parse(const vector<string> &args) {
+    auto argv = create_argv(args);
+    Parser::preprocess(static_cast<int>(argv.size()), argv.data());
+
+    auto verbose = Parser::countFlag("v,verbose", "Verbose output.");
+    auto color   = Parser::hasMutualExFlag({"c,color", "Enable color.", "C,no-color", "Disable color.", true});
+    auto count   = Parser::get<int>("n,count", "Counter.").setDefault(3).get();
+    auto rate    = Parser::get<double>("r,rate", "Rate.").setDefault(0.1).get();
+    auto name    = Parser::get<string>("name", "Name.").setDefault("nobody").get();
+    auto level   = Parser::get<optional<int>>("l,level", "Level.").get();
+    auto ids     = Parser::get<int>("i,id", "Identifiers.").getVec(',');
+    auto input   = Parser::getPositional("input", "Input file.");
+    auto extra   = Parser::getRemainingPositionals<int>("extra", "Extra numbers.", false, {7, 8});
+    (void)verbose, (void)color, (void)count, (void)rate, (void)name, (void)level, (void)ids, (void)input, (void)extra;
+
+    auto snapshot = Parser::snapshot();
+    assert(!Parser::runAllPostprocess(true));
+    return snapshot;
+}
+
+void testSnapshotValues() {
+    cerr << "--- Testing snapshot values ---\n";
+    auto args = parse({"./snap", "-vv", "--verbose", "-C", "-n", "42", "-r", "0.123456789",
+                       "--id", "1,2", "-i", "3", "in.txt", "10", "20"});
+
+    assert(args->count("v") == 3);
+    assert(args->count("verbose") == 3);
+    assert(args->getString("verbose").empty());
+
+    assert(args->get<bool>("color", true) == false);
+    assert(args->get<bool>("no-color") == true);
+    assert(args->count("C") == 1);
+
+    assert(args->get<int>("n") == 42);
+    assert(args->get<int>("count") == 42);
+    assert(args->count("count") == 1);
+    // Values are stored without losing precision
+    assert(args->get<double>("rate") == 0.123456789);
+
+    // Defaults are stored as the returned value
+    assert(args->getString("name") == "nobody");
+    assert(args->count("name") == 0);
+    assert(args->contains("level"));
+    assert(!args->get<optional<int>>("level").has_value());
+    assert(args->get<int>("level", -1) == -1);
+
+    assert((args->getVec<int>("id") == vector<int>{1, 2, 3}));
+    assert(args->count("id") == 2);
+
+    assert(args->getString("input") == "in.txt");
+    assert((args->getVec<int>("extra") == vector<int>{10, 20}));
+    assert(args->count("extra") == 2);
+
+    assert(!args->contains("unknown"));
+    assert(args->getString("unknown", "fallback") == "fallback");
+
+    cerr << "Snapshot values PASSED\n"
+         << '\n';
+}
+
+void testSnapshotOutlivesParsing() {
+    cerr << "--- Testing snapshot lifetime ---\n";
+    auto first  = parse({"./snap", "first"});
+    auto second = parse({"./snap", "--name", "Ada", "second"});
+
+    // Each snapshot owns its data
+    assert(first->getString("input") == "first");
+    assert(first->getString("name") == "nobody");
+    assert((first->getVec<int>("extra") == vector<int>{7, 8}));
+    assert(first->count("extra") == 0);
+    assert(second->getString("input") == "second");
+    assert(second->getString("name") == "Ada");
+
+    // Shared by pointer
+    auto copy = second;
+    assert(copy.get() == second.get());
+
+    cerr << "Snapshot lifetime PASSED\n"
+         << '\n';
+}
+
+void testImageRoundTrip() {
+    cerr << "--- Testing binary images ---\n";
+    auto args = parse({"./snap", "-v", "--name", "Ada", "-i", "1,2", "in.txt", "10"});
+
+    // A uint32_t vector keeps the image aligned
+    vector<uint32_t> image((args->imageSize() + 3) / 4);
+    assert(args->serialize(image.data(), args->imageSize() - 1) == 0);
+    assert(args->serialize(image.data(), image.size() * 4) == args->imageSize());
+
+    auto attached = ParsedArgs::attach(image.data(), args->imageSize());
+    assert(attached);
+    assert(attached->count("verbose") == 1);
+    assert(attached->getString("name") == "Ada");
+    assert(attached->get<int>("count") == 3);
+    assert((attached->getVec<int>("id") == vector<int>{1, 2}));
+    assert(attached->getString("input") == "in.txt");
+    assert((attached->getVec<int>("extra") == vector<int>{10}));
+    assert(!attached->contains("unknown"));
+    // An attached snapshot can be written again
+    assert(attached->imageSize() == args->imageSize());
+
+    // Truncated, misaligned and other versions are rejected
+    assert(!ParsedArgs::attach(image.data(), args->imageSize() - 1));
+    vector<char> shifted(args->imageSize() + 1);
+    memcpy(shifted.data() + 1, image.data(), args->imageSize());
+    assert(!ParsedArgs::attach(shifted.data() + 1, args->imageSize()));
+    auto rejects = [&image, &args](size_t word, uint32_t value) {
+        auto corrupt  = image;
+        corrupt[word] = value;
+        return !ParsedArgs::attach(corrupt.data(), args->imageSize());
+    };
+    assert(rejects(1, ParsedArgs::IMAGE_VERSION + 1));
+    // The layout of the header, entries (5 words each) and value slices (2 words each)
+    const size_t entrySizeWord = 2;
+    const size_t entryCount    = image[4];
+    const size_t entriesWord   = 7;
+    const size_t valuesWord    = entriesWord + (entryCount * 5);
+    assert(rejects(entrySizeWord, image[entrySizeWord] + 4));
+    // A corrupt table is rejected instead of read out of bounds
+    assert(rejects(entriesWord, 0xFFFFFFF0));       // Name offset of the first entry
+    assert(rejects(entriesWord + 1, image[6] + 1)); // Name size past the text
+    assert(rejects(entriesWord + 3, 0xFFFFFFFF));   // First value, overflows with the count
+    assert(rejects(entriesWord + 4, image[5] + 1)); // Value count past the values
+    assert(rejects(valuesWord, image[6]));          // Value offset at the end of the text
+    assert(rejects(valuesWord + 1, 0xFFFFFFFF));    // Value size
+    assert(rejects(4, 0x40000000));                 // Entry count larger than the image
+    // Entries out of order
+    auto swapped = image;
+    swap_ranges(swapped.begin() + entriesWord, swapped.begin() + entriesWord + 5, swapped.begin() + entriesWord + 5);
+    assert(!ParsedArgs::attach(swapped.data(), args->imageSize()));
+
+    cerr << "Binary images PASSED\n"
+         << '\n';
+}
+
+int main() {
+    Parser::setSnapshotEnabled();
+
+    testSnapshotValues();
+    testSnapshotOutlivesParsing();
+    testImageRoundTrip();
+
+    cerr << "All tests passed!\n";
+
+    return 0;
+}